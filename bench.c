@@ -0,0 +1,1216 @@
+/**
+ * @file bench.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains the benchmark suite for the Key Value parser. A deterministic synthetic
+ * corpus is generated and each engine is timed over it. Results are printed one per line as
+ * space separated `key=value` fields so they can be diffed or parsed by scripts.
+ *
+ * Options are passed as `key=value` arguments (e.g. `./bench lines=100000 quote=20`):
+ *   seed        Generator seed (default 1)
+ *   lines       Lines in the corpus, including headers and comments (default 20000)
+ *   key_min     Shortest key (default 4)
+ *   key_max     Longest key (default 24)
+ *   value_min   Shortest value (default 1)
+ *   value_max   Longest value (default 64)
+ *   section     One section header every n lines on average, 0 for none (default 200)
+ *   quote       Percentage of quoted values (default 10)
+ *   number      Percentage of integer values, 0 reproduces corpora from before the option (default 10)
+ *   comment     Percentage of comment lines (default 5)
+ *   lookups     Distinct keys looked up per engine (default 256)
+ *   min_ms      Minimum time spent per measurement (default 200)
+ *   primitives  Also time each parsing primitive on its own, 0 to skip (default 1)
+ *
+ * Primitive timings report cycles per byte, branch misses and cache misses from hardware
+ * counters via `perf_event_open()` on Linux. Where counters are unavailable (other systems,
+ * containers, `perf_event_paranoid`) only ns per byte from `clock_gettime()` is reported.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE /* syscall() */
+#endif
+
+#include "kv_parse.h"
+#include "kv_parse_bloom.h"
+#include "kv_parse_buffer.h"
+#include "kv_parse_index.h"
+#include "kv_parse_kvc.h"
+#include "kv_parse_kvidx.h"
+#include "kv_parse_lines.h"
+#ifdef __linux__
+#include "kv_parse_live.h"
+#endif
+#include "kv_parse_map.h"
+#include "kv_parse_pread.h"
+#include "kv_parse_reader.h"
+#include "kv_parse_section.h"
+#include "kv_parse_stream.h"
+#include "kv_parse_typed.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_PERF_EVENTS
+#endif
+
+#define BENCH_CORPUS_PATH "bench_corpus.env"
+#define BENCH_IMAGE_PATH "bench_corpus.kvc"
+
+/* Variant label. "all" or every disabled feature, e.g. "no_whitespace_skip+no_simd" */
+#define BENCH_VARIANT bench_variant()
+
+static const char *bench_variant(void)
+{
+    static const char *const disabled[] = {
+#ifdef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        "no_whitespace_skip",
+#endif
+#ifdef KV_PARSE_DISABLE_QUOTED_STRINGS
+        "no_quoted_strings",
+#endif
+#ifdef KV_PARSE_DISABLE_SIMD
+        "no_simd",
+#endif
+#ifdef KV_PARSE_DISABLE_THREADS
+        "no_threads",
+#endif
+        NULL};
+    static char label[80];
+
+    if (label[0] == '\0')
+    {
+        strcpy(label, (disabled[0] == NULL) ? "all" : disabled[0]);
+        for (size_t i = 1; disabled[i] != NULL; i++)
+        {
+            strcat(label, "+");
+            strcat(label, disabled[i]);
+        }
+    }
+    return label;
+}
+
+/* Keeps results alive so timed calls are not optimised out */
+static volatile size_t bench_sink;
+
+typedef struct bench_config
+{
+    unsigned long seed;
+    size_t lines;
+    size_t key_min;
+    size_t key_max;
+    size_t value_min;
+    size_t value_max;
+    size_t section;
+    size_t quote;
+    size_t number;
+    size_t comment;
+    size_t lookups;
+    size_t min_ms;
+} bench_config;
+
+typedef struct bench_corpus
+{
+    char *data;
+    size_t size;
+    size_t keys;
+    char **key;      /* Null terminated copy of each key */
+    char **section;  /* Section name of each key, "" before the first header */
+    size_t sections; /* Section headers */
+} bench_corpus;
+
+/* Inputs of one primitive. `ptr` into the buffer copy, `offset` into the corpus file */
+typedef struct bench_set
+{
+    size_t count;
+    size_t bytes;
+    char **ptr;
+    long *offset;
+    const char **key;
+    char **miss_key;
+    kv_key *key_desc;
+    kv_key *miss_key_desc;
+} bench_set;
+
+typedef struct bench_ctx
+{
+    bench_config *config;
+    bench_corpus *corpus;
+    FILE *file;
+    char *copy;
+    kv_parse_index *index;
+    kv_parse_sections *dir;
+    kv_parse_map *map;
+    kv_parse_kvc *kvc;
+#ifdef __linux__
+    kv_parse_live *live;
+#endif
+    kv_parse_lines *offsets;
+    kv_parse_bloom *bloom;
+    unsigned char *image;
+    size_t image_max;
+    char value[4096];
+
+    /* Primitive Inputs */
+    bench_set lines;
+    bench_set keys;
+    bench_set plain_values;
+    bench_set quoted_values;
+    bench_set number_values;
+    bench_set headers;
+} bench_ctx;
+
+/* Hardware counters of one measurement */
+enum
+{
+    BENCH_CYCLES,
+    BENCH_BRANCH_MISSES,
+    BENCH_CACHE_MISSES,
+    BENCH_COUNTERS
+};
+
+typedef struct bench_counters
+{
+    bool enabled;
+    int fd[BENCH_COUNTERS];
+    uint64_t value[BENCH_COUNTERS];
+} bench_counters;
+
+/*******************************************************************************
+ * Corpus Generator
+ ******************************************************************************/
+
+static uint64_t bench_rand_state;
+
+static uint64_t bench_rand(void)
+{
+    /* xorshift64* */
+    bench_rand_state ^= bench_rand_state >> 12;
+    bench_rand_state ^= bench_rand_state << 25;
+    bench_rand_state ^= bench_rand_state >> 27;
+    return bench_rand_state * 2685821657736338717ull;
+}
+
+static size_t bench_rand_range(size_t min, size_t max)
+{
+    return (max <= min) ? min : min + (size_t)(bench_rand() % (max - min + 1));
+}
+
+static char *bench_put_chars(char *out, size_t len, const char *charset)
+{
+    size_t charset_len = strlen(charset);
+    for (size_t i = 0; i < len; i++)
+    {
+        *out++ = charset[bench_rand() % charset_len];
+    }
+    return out;
+}
+
+static bool bench_generate(const bench_config *config, bench_corpus *corpus)
+{
+    /* Worst case line: quoted value, key suffix, whitespace and newline */
+    size_t line_max = config->key_max + config->value_max + 64;
+    corpus->data = malloc(config->lines * line_max + 1);
+    corpus->key = malloc(config->lines * sizeof(char *));
+    corpus->section = malloc(config->lines * sizeof(char *));
+    if (corpus->data == NULL || corpus->key == NULL || corpus->section == NULL)
+    {
+        return false;
+    }
+
+    bench_rand_state = config->seed * 0x9E3779B97F4A7C15ull + 1;
+    corpus->keys = 0;
+    corpus->sections = 0;
+
+    char *out = corpus->data;
+    char *section = "";
+    for (size_t line = 0; line < config->lines; line++)
+    {
+        char *start = out;
+        if (config->section > 0 && bench_rand() % config->section == 0)
+        {
+            /* Section Header */
+            out += sprintf(out, "[section%zu]\n", corpus->sections++);
+            section = malloc((size_t)(out - start));
+            memcpy(section, start + 1, (size_t)(out - start) - 3);
+            section[(size_t)(out - start) - 3] = '\0';
+            continue;
+        }
+
+        if (bench_rand() % 100 < config->comment)
+        {
+            /* Comment Line */
+            *out++ = '#';
+            *out++ = ' ';
+            out = bench_put_chars(out, bench_rand_range(config->value_min, config->value_max), "abcdefghijklmnopqrstuvwxyz ");
+            *out++ = '\n';
+            continue;
+        }
+
+        /* Key. Suffixed with the key number to keep keys unique */
+        size_t key_len = bench_rand_range(config->key_min, config->key_max);
+        char *key = out;
+        out = bench_put_chars(out, key_len, "abcdefghijklmnopqrstuvwxyz_");
+        out += sprintf(out, "%zu", corpus->keys);
+        key_len = (size_t)(out - key);
+
+        corpus->key[corpus->keys] = malloc(key_len + 1);
+        memcpy(corpus->key[corpus->keys], key, key_len);
+        corpus->key[corpus->keys][key_len] = '\0';
+        corpus->section[corpus->keys] = section;
+        corpus->keys++;
+
+        /* Delimiter, with whitespace on some lines */
+        out += sprintf(out, (bench_rand() % 4 == 0) ? " = " : "=");
+
+        /* Value */
+        size_t value_len = bench_rand_range(config->value_min, config->value_max);
+        if (config->number > 0 && bench_rand() % 100 < config->number)
+        {
+            /* Integer that fits an int64_t */
+            out = bench_put_chars(out, 1, "123456789");
+            out = bench_put_chars(out, bench_rand_range(0, 17), "0123456789");
+        }
+        else if (bench_rand() % 100 < config->quote)
+        {
+            *out++ = '"';
+            out = bench_put_chars(out, value_len, "abcdefghijklmnopqrstuvwxyz0123456789 =:/.");
+            *out++ = '"';
+        }
+        else
+        {
+            out = bench_put_chars(out, value_len, "abcdefghijklmnopqrstuvwxyz0123456789/.");
+        }
+        *out++ = '\n';
+    }
+
+    *out = '\0';
+    corpus->size = (size_t)(out - corpus->data);
+    return corpus->keys > 0;
+}
+
+/*******************************************************************************
+ * Timing
+ ******************************************************************************/
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Runs `fn` until `min_ms` has passed. Returns seconds per call */
+static double bench_time(void (*fn)(bench_ctx *ctx, size_t i), bench_ctx *ctx)
+{
+    size_t calls = 0;
+    double start = bench_now();
+    double elapsed = 0;
+    do
+    {
+        fn(ctx, calls++);
+        elapsed = bench_now() - start;
+    } while (elapsed * 1000 < (double)ctx->config->min_ms);
+    return elapsed / (double)calls;
+}
+
+static void bench_report_scan(const char *engine, const char *op, double seconds, size_t bytes)
+{
+    printf("variant=%s engine=%s op=%s mb_per_s=%.1f\n", BENCH_VARIANT, engine, op, (double)bytes / seconds / 1e6);
+}
+
+static void bench_report_lookup(const char *engine, const char *op, double seconds, size_t lookups)
+{
+    printf("variant=%s engine=%s op=%s ns_per_lookup=%.1f\n", BENCH_VARIANT, engine, op, seconds / (double)lookups * 1e9);
+}
+
+/* Key of the i-th lookup. Keys are spread evenly over the corpus */
+static const char *bench_key(bench_ctx *ctx, size_t i)
+{
+    return ctx->corpus->key[(i % ctx->config->lookups) * ctx->corpus->keys / ctx->config->lookups];
+}
+
+static const char *bench_section(bench_ctx *ctx, size_t i)
+{
+    return ctx->corpus->section[(i % ctx->config->lookups) * ctx->corpus->keys / ctx->config->lookups];
+}
+
+/*******************************************************************************
+ * Engines
+ ******************************************************************************/
+
+#define BENCH_MISSING_KEY "bench_missing_key"
+
+static size_t bench_buffer_get(char *input, const char *key, char *value, size_t value_max)
+{
+    for (size_t line = 0; (input = kv_parse_buffer_next_line(input, line)) != NULL; line++)
+    {
+        char *input_value = NULL;
+        if ((input_value = kv_parse_buffer_check_key(input, key)) != NULL)
+        {
+            return kv_parse_buffer_get_value(input_value, value, value_max);
+        }
+    }
+    return 0;
+}
+
+static size_t bench_span_get(const char *input, const char *end, const char *key, char *value, size_t value_max)
+{
+    for (size_t line = 0; (input = kv_parse_span_next_line(input, end, line)) != NULL; line++)
+    {
+        const char *input_value = NULL;
+        if ((input_value = kv_parse_span_check_key(input, end, key)) != NULL)
+        {
+            return kv_parse_span_get_value(input_value, end, value, value_max);
+        }
+    }
+    return 0;
+}
+
+static size_t bench_file_get(FILE *file, const char *key, char *value, size_t value_max)
+{
+    rewind(file);
+    for (size_t line = 0; kv_parse_next_line(file, line); line++)
+    {
+        if (kv_parse_check_key(file, key))
+        {
+            return kv_parse_get_value(file, value, value_max);
+        }
+    }
+    return 0;
+}
+
+static size_t bench_reader_get(FILE *file, const char *key, char *value, size_t value_max)
+{
+    static char block[64 * 1024];
+    kv_parse_reader reader;
+    kv_parse_reader_init(&reader, file, block, sizeof(block));
+    kv_parse_reader_rewind(&reader);
+    for (size_t line = 0; kv_parse_reader_next_line(&reader, line); line++)
+    {
+        if (kv_parse_reader_check_key(&reader, key))
+        {
+            return kv_parse_reader_get_value(&reader, value, value_max);
+        }
+    }
+    return 0;
+}
+
+static void bench_buffer_miss(bench_ctx *ctx, size_t i)
+{
+    bench_sink += bench_buffer_get(ctx->copy, BENCH_MISSING_KEY, ctx->value, sizeof(ctx->value));
+}
+
+static void bench_buffer_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += bench_buffer_get(ctx->copy, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_span_miss(bench_ctx *ctx, size_t i)
+{
+    bench_sink += bench_span_get(ctx->corpus->data, ctx->corpus->data + ctx->corpus->size, BENCH_MISSING_KEY, ctx->value, sizeof(ctx->value));
+}
+
+static void bench_span_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += bench_span_get(ctx->corpus->data, ctx->corpus->data + ctx->corpus->size, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_file_miss(bench_ctx *ctx, size_t i)
+{
+    bench_sink += bench_file_get(ctx->file, BENCH_MISSING_KEY, ctx->value, sizeof(ctx->value));
+}
+
+static void bench_file_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += bench_file_get(ctx->file, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_lines_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_lines_get(ctx->offsets, ctx->file, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+/* Line spread over the corpus, reached by walking from the start */
+static void bench_file_seek(bench_ctx *ctx, size_t i)
+{
+    size_t target = (i % ctx->config->lookups) * ctx->config->lines / ctx->config->lookups;
+    rewind(ctx->file);
+    for (size_t line = 1; line <= target && kv_parse_next_line(ctx->file, line); line++)
+    {
+    }
+    bench_sink += (size_t)getc(ctx->file);
+}
+
+static void bench_lines_seek(bench_ctx *ctx, size_t i)
+{
+    size_t target = (i % ctx->config->lookups) * ctx->config->lines / ctx->config->lookups;
+    kv_parse_seek_line(ctx->offsets, ctx->file, target);
+    bench_sink += (size_t)getc(ctx->file);
+}
+
+static void bench_reader_miss(bench_ctx *ctx, size_t i)
+{
+    bench_sink += bench_reader_get(ctx->file, BENCH_MISSING_KEY, ctx->value, sizeof(ctx->value));
+}
+
+static void bench_reader_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += bench_reader_get(ctx->file, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_pread_miss(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_pread_get(fileno(ctx->file), BENCH_MISSING_KEY, ctx->value, sizeof(ctx->value));
+}
+
+static void bench_pread_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_pread_get(fileno(ctx->file), bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_map_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_map_get(ctx->map, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_map_startup(bench_ctx *ctx, size_t i)
+{
+    kv_parse_map map;
+    if (kv_parse_map_open(&map, BENCH_CORPUS_PATH))
+    {
+        bench_sink += kv_parse_map_get(&map, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+        kv_parse_map_close(&map);
+    }
+}
+
+static void bench_iter_scan(bench_ctx *ctx, size_t i)
+{
+    kv_parse_buffer_iter it;
+    kv_parse_record rec;
+    kv_parse_buffer_iter_init(&it, ctx->corpus->data);
+    while (kv_parse_buffer_iter_next(&it, &rec))
+    {
+        bench_sink += rec.value.len;
+    }
+}
+
+static void bench_stream_scan(bench_ctx *ctx, size_t i)
+{
+    char key[4096];
+    kv_parse_stream stream;
+    kv_parse_stream_init(&stream, key, sizeof(key), ctx->value, sizeof(ctx->value), NULL, 0);
+    for (size_t pos = 0; pos < ctx->corpus->size;)
+    {
+        pos += kv_parse_stream_feed(&stream, ctx->corpus->data + pos, ctx->corpus->size - pos);
+        bench_sink += stream.value_len;
+    }
+    bench_sink += kv_parse_stream_finish(&stream);
+}
+
+static void bench_index_build(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_buffer_index(ctx->index, ctx->copy);
+}
+
+static void bench_bloom_build(bench_ctx *ctx, size_t i)
+{
+    kv_parse_bloom_init(ctx->bloom, ctx->bloom->bits, ((size_t)ctx->bloom->bit_count + 7) / 8);
+    kv_parse_index_bloom(ctx->bloom, ctx->index);
+    bench_sink += ctx->bloom->count;
+}
+
+/* Keys known to be absent. Misses rotate over all of them, so the few false positives weigh in at their real rate */
+#define BENCH_ABSENT_KEYS 1024
+static char bench_absent[BENCH_ABSENT_KEYS][32];
+
+static void bench_absent_init(void)
+{
+    for (size_t i = 0; i < BENCH_ABSENT_KEYS; i++)
+    {
+        sprintf(bench_absent[i], "bench_absent_%zu", i);
+    }
+}
+
+static const char *bench_absent_key(size_t i)
+{
+    return bench_absent[i % BENCH_ABSENT_KEYS];
+}
+
+static void bench_bloom_miss(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_bloom_check(ctx->bloom, bench_absent_key(i));
+}
+
+/* Bloom filter in front of the FILE engine, as done for optional keys */
+static void bench_bloom_file_miss(bench_ctx *ctx, size_t i)
+{
+    const char *key = bench_absent_key(i);
+    if (kv_parse_bloom_check(ctx->bloom, key))
+    {
+        bench_sink += bench_file_get(ctx->file, key, ctx->value, sizeof(ctx->value));
+    }
+}
+
+/* Share of keys known to be absent that the filter cannot reject */
+static double bench_bloom_false_positive_rate(const kv_parse_bloom *bloom, size_t probes)
+{
+    char key[64];
+    size_t false_positives = 0;
+    for (size_t i = 0; i < probes; i++)
+    {
+        sprintf(key, "bench_absent_%zu", i);
+        false_positives += kv_parse_bloom_check(bloom, key);
+    }
+    return (double)false_positives / (double)probes;
+}
+
+static void bench_index_parallel_build(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_buffer_index_parallel(ctx->index, ctx->copy, 0);
+}
+
+static void bench_index_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_index_get(ctx->index, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_kvc_build(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_kvc_compile(ctx->corpus->data, ctx->image, ctx->image_max);
+}
+
+static void bench_kvc_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_kvc_get(ctx->kvc, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_kvc_startup(bench_ctx *ctx, size_t i)
+{
+    kv_parse_kvc kvc;
+    if (kv_parse_kvc_open(&kvc, BENCH_IMAGE_PATH))
+    {
+        bench_sink += kv_parse_kvc_get(&kvc, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+        kv_parse_kvc_close(&kvc);
+    }
+}
+
+static void bench_kvidx_build(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_kvidx_build(BENCH_CORPUS_PATH);
+}
+
+static void bench_kvidx_startup(bench_ctx *ctx, size_t i)
+{
+    kv_parse_kvc kvc;
+    if (kv_parse_kvidx_open(&kvc, BENCH_CORPUS_PATH))
+    {
+        bench_sink += kv_parse_kvc_get(&kvc, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+        kv_parse_kvc_close(&kvc);
+    }
+}
+
+#ifdef __linux__
+static void bench_live_reload(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_live_reload(ctx->live);
+}
+
+static void bench_live_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_live_get(ctx->live, 0, bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+#endif
+
+static void bench_sections_build(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_buffer_sections(ctx->dir, ctx->corpus->data);
+}
+
+static void bench_sections_lookup(bench_ctx *ctx, size_t i)
+{
+    bench_sink += kv_parse_buffer_section_get(ctx->dir, bench_section(ctx, i), bench_key(ctx, i), ctx->value, sizeof(ctx->value));
+}
+
+static void bench_get_many(bench_ctx *ctx, size_t i)
+{
+    static kv_parse_buffer_query queries[64];
+    static char values[64][4096];
+    size_t count = ctx->config->lookups < 64 ? ctx->config->lookups : 64;
+    for (size_t q = 0; q < count; q++)
+    {
+        queries[q].key = bench_key(ctx, q * ctx->config->lookups / count);
+        queries[q].value = values[q];
+        queries[q].value_max = sizeof(values[q]);
+    }
+    bench_sink += kv_parse_buffer_get_many(ctx->copy, queries, count);
+}
+
+/*******************************************************************************
+ * Hardware Counters
+ ******************************************************************************/
+
+static void bench_counters_open(bench_counters *counters)
+{
+    counters->enabled = false;
+#ifdef BENCH_PERF_EVENTS
+    static const uint64_t config[BENCH_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < BENCH_COUNTERS; i++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config[i];
+        attr.disabled = (i == 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        /* Counters form a group led by the cycle counter so they run together */
+        counters->fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, (i == 0) ? -1 : counters->fd[0], 0);
+        if (counters->fd[i] < 0)
+        {
+            /* Counters unavailable. Fall back to timing only */
+            while (--i >= 0)
+            {
+                close(counters->fd[i]);
+            }
+            return;
+        }
+    }
+    counters->enabled = true;
+#endif
+}
+
+static void bench_counters_start(bench_counters *counters)
+{
+#ifdef BENCH_PERF_EVENTS
+    if (counters->enabled)
+    {
+        ioctl(counters->fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(counters->fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+static void bench_counters_stop(bench_counters *counters)
+{
+#ifdef BENCH_PERF_EVENTS
+    if (counters->enabled)
+    {
+        /* Group read format: number of counters followed by each value */
+        uint64_t data[1 + BENCH_COUNTERS];
+        ioctl(counters->fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        if (read(counters->fd[0], data, sizeof(data)) == (ssize_t)sizeof(data))
+        {
+            memcpy(counters->value, data + 1, sizeof(counters->value));
+        }
+    }
+#endif
+}
+
+static void bench_counters_close(bench_counters *counters)
+{
+#ifdef BENCH_PERF_EVENTS
+    for (int i = 0; counters->enabled && i < BENCH_COUNTERS; i++)
+    {
+        close(counters->fd[i]);
+    }
+#endif
+}
+
+/*******************************************************************************
+ * Primitives
+ ******************************************************************************/
+
+static void bench_set_alloc(bench_set *set, size_t count)
+{
+    set->count = 0;
+    set->bytes = 0;
+    set->ptr = malloc(count * sizeof(char *));
+    set->offset = malloc(count * sizeof(long));
+    set->key = malloc(count * sizeof(char *));
+    set->miss_key = malloc(count * sizeof(char *));
+    set->key_desc = malloc(count * sizeof(kv_key));
+    set->miss_key_desc = malloc(count * sizeof(kv_key));
+}
+
+static void bench_set_add(bench_set *set, char *ptr, const char *base, size_t bytes)
+{
+    set->ptr[set->count] = ptr;
+    set->offset[set->count] = (long)(ptr - base);
+    set->bytes += bytes;
+    set->count++;
+}
+
+/* Sorts the lines of the buffer copy into inputs for each primitive */
+static void bench_primitives_prepare(bench_ctx *ctx)
+{
+    char *copy = ctx->copy;
+    size_t lines = ctx->config->lines;
+    bench_set_alloc(&ctx->lines, lines);
+    bench_set_alloc(&ctx->keys, lines);
+    bench_set_alloc(&ctx->plain_values, lines);
+    bench_set_alloc(&ctx->quoted_values, lines);
+    bench_set_alloc(&ctx->number_values, lines);
+    bench_set_alloc(&ctx->headers, lines);
+
+    size_t key = 0;
+    char *str = copy;
+    for (size_t line = 0; (str = kv_parse_buffer_next_line(str, line)) != NULL; line++)
+    {
+        size_t len = (size_t)(kv_parse_buffer_scan_line(str) - str);
+        bench_set_add(&ctx->lines, str, copy, len + 1);
+
+        if (*str == '[')
+        {
+            bench_set_add(&ctx->headers, str, copy, len + 1);
+            continue;
+        }
+
+        if (*str == '#')
+        {
+            continue;
+        }
+
+        /* Key line. Keys are generated in line order */
+        const char *line_key = ctx->corpus->key[key++];
+        char *value = kv_parse_buffer_check_key(str, line_key);
+        if (value == NULL)
+        {
+            /* Key does not parse in this variant */
+            continue;
+        }
+
+        /* Miss key differs in the last character so the whole key is compared */
+        size_t key_len = strlen(line_key);
+        char *miss_key = malloc(key_len + 1);
+        memcpy(miss_key, line_key, key_len + 1);
+        miss_key[key_len - 1] = (miss_key[key_len - 1] == '0') ? '1' : '0';
+
+        ctx->keys.key[ctx->keys.count] = line_key;
+        ctx->keys.miss_key[ctx->keys.count] = miss_key;
+        ctx->keys.key_desc[ctx->keys.count] = kv_parse_key(line_key);
+        ctx->keys.miss_key_desc[ctx->keys.count] = kv_parse_key(miss_key);
+        bench_set_add(&ctx->keys, str, copy, (size_t)(value - str));
+
+        int64_t number;
+        bench_set *values = (memchr(value, '"', (size_t)(str + len - value)) != NULL) ? &ctx->quoted_values : &ctx->plain_values;
+        if (kv_parse_buffer_get_i64(value, &number) == KV_PARSE_OK && strspn(value, " 0123456789") == (size_t)(str + len - value))
+        {
+            values = &ctx->number_values;
+        }
+        bench_set_add(values, value, copy, (size_t)(str + len - value));
+    }
+}
+
+static void bench_buffer_next_line(bench_ctx *ctx, size_t i)
+{
+    char *str = ctx->copy;
+    for (size_t line = 0; (str = kv_parse_buffer_next_line(str, line)) != NULL; line++)
+    {
+        bench_sink += (size_t)*str;
+    }
+}
+
+static void bench_buffer_check_key_hit(bench_ctx *ctx, size_t i)
+{
+    for (size_t n = 0; n < ctx->keys.count; n++)
+    {
+        bench_sink += (kv_parse_buffer_check_key(ctx->keys.ptr[n], ctx->keys.key[n]) != NULL);
+    }
+}
+
+static void bench_buffer_check_key_miss(bench_ctx *ctx, size_t i)
+{
+    for (size_t n = 0; n < ctx->keys.count; n++)
+    {
+        bench_sink += (kv_parse_buffer_check_key(ctx->keys.ptr[n], ctx->keys.miss_key[n]) != NULL);
+    }
+}
+
+static void bench_buffer_match_key_hit(bench_ctx *ctx, size_t i)
+{
+    for (size_t n = 0; n < ctx->keys.count; n++)
+    {
+        bench_sink += (kv_parse_buffer_match_key(ctx->keys.ptr[n], &ctx->keys.key_desc[n]) != NULL);
+    }
+}
+
+static void bench_buffer_match_key_miss(bench_ctx *ctx, size_t i)
+{
+    for (size_t n = 0; n < ctx->keys.count; n++)
+    {
+        bench_sink += (kv_parse_buffer_match_key(ctx->keys.ptr[n], &ctx->keys.miss_key_desc[n]) != NULL);
+    }
+}
+
+static void bench_buffer_get_values(bench_ctx *ctx, const bench_set *set)
+{
+    for (size_t n = 0; n < set->count; n++)
+    {
+        bench_sink += kv_parse_buffer_get_value(set->ptr[n], ctx->value, sizeof(ctx->value));
+    }
+}
+
+static void bench_buffer_get_value_plain(bench_ctx *ctx, size_t i)
+{
+    bench_buffer_get_values(ctx, &ctx->plain_values);
+}
+
+static void bench_buffer_get_value_quoted(bench_ctx *ctx, size_t i)
+{
+    bench_buffer_get_values(ctx, &ctx->quoted_values);
+}
+
+static void bench_buffer_get_value_strtoll(bench_ctx *ctx, size_t i)
+{
+    /* Copy then parse, as callers did before the typed accessors */
+    for (size_t n = 0; n < ctx->number_values.count; n++)
+    {
+        kv_parse_buffer_get_value(ctx->number_values.ptr[n], ctx->value, sizeof(ctx->value));
+        bench_sink += (size_t)strtoll(ctx->value, NULL, 10);
+    }
+}
+
+static void bench_buffer_get_i64(bench_ctx *ctx, size_t i)
+{
+    for (size_t n = 0; n < ctx->number_values.count; n++)
+    {
+        int64_t number = 0;
+        kv_parse_buffer_get_i64(ctx->number_values.ptr[n], &number);
+        bench_sink += (size_t)number;
+    }
+}
+
+static void bench_buffer_check_section(bench_ctx *ctx, size_t i)
+{
+    for (size_t n = 0; n < ctx->headers.count; n++)
+    {
+        bench_sink += kv_parse_buffer_check_section(ctx->headers.ptr[n], ctx->value, sizeof(ctx->value));
+    }
+}
+
+static void bench_file_next_line(bench_ctx *ctx, size_t i)
+{
+    rewind(ctx->file);
+    for (size_t line = 0; kv_parse_next_line(ctx->file, line); line++)
+    {
+        bench_sink++;
+    }
+}
+
+static void bench_file_check_key(bench_ctx *ctx, const char **keys)
+{
+    for (size_t n = 0; n < ctx->keys.count; n++)
+    {
+        fseek(ctx->file, ctx->keys.offset[n], SEEK_SET);
+        bench_sink += kv_parse_check_key(ctx->file, keys[n]);
+    }
+}
+
+static void bench_file_check_key_hit(bench_ctx *ctx, size_t i)
+{
+    bench_file_check_key(ctx, ctx->keys.key);
+}
+
+static void bench_file_check_key_miss(bench_ctx *ctx, size_t i)
+{
+    bench_file_check_key(ctx, (const char **)ctx->keys.miss_key);
+}
+
+static void bench_file_get_values(bench_ctx *ctx, const bench_set *set)
+{
+    for (size_t n = 0; n < set->count; n++)
+    {
+        fseek(ctx->file, set->offset[n], SEEK_SET);
+        bench_sink += kv_parse_get_value(ctx->file, ctx->value, sizeof(ctx->value));
+    }
+}
+
+static void bench_file_get_value_plain(bench_ctx *ctx, size_t i)
+{
+    bench_file_get_values(ctx, &ctx->plain_values);
+}
+
+static void bench_file_get_value_quoted(bench_ctx *ctx, size_t i)
+{
+    bench_file_get_values(ctx, &ctx->quoted_values);
+}
+
+static void bench_file_check_section(bench_ctx *ctx, size_t i)
+{
+    for (size_t n = 0; n < ctx->headers.count; n++)
+    {
+        fseek(ctx->file, ctx->headers.offset[n], SEEK_SET);
+        bench_sink += kv_parse_check_section(ctx->file, ctx->value, sizeof(ctx->value));
+    }
+}
+
+/* Times passes of a primitive over its inputs and reports per byte costs */
+static void bench_primitive(const char *name, void (*fn)(bench_ctx *ctx, size_t i), bench_ctx *ctx, const bench_set *set, bench_counters *counters)
+{
+    if (set->count == 0)
+    {
+        /* Nothing in the corpus to measure */
+        return;
+    }
+
+    size_t passes = 0;
+    double start = bench_now();
+    double elapsed = 0;
+    bench_counters_start(counters);
+    do
+    {
+        fn(ctx, passes++);
+        elapsed = bench_now() - start;
+    } while (elapsed * 1000 < (double)ctx->config->min_ms);
+    bench_counters_stop(counters);
+
+    double bytes = (double)set->bytes * (double)passes;
+    printf("variant=%s primitive=%s bytes=%zu ns_per_byte=%.3f", BENCH_VARIANT, name, set->bytes, elapsed * 1e9 / bytes);
+    if (counters->enabled)
+    {
+        printf(" cycles_per_byte=%.3f branch_misses_per_kb=%.3f cache_misses_per_kb=%.3f", (double)counters->value[BENCH_CYCLES] / bytes,
+               (double)counters->value[BENCH_BRANCH_MISSES] * 1000 / bytes, (double)counters->value[BENCH_CACHE_MISSES] * 1000 / bytes);
+    }
+    else
+    {
+        printf(" counters=none");
+    }
+    printf("\n");
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+static size_t bench_option(int argc, char **argv, const char *key, size_t fallback)
+{
+    char value[32];
+    for (int i = 1; i < argc; i++)
+    {
+        char *input_value = kv_parse_buffer_check_key(argv[i], key);
+        if (input_value != NULL && kv_parse_buffer_get_value(input_value, value, sizeof(value)) > 0)
+        {
+            return (size_t)strtoull(value, NULL, 10);
+        }
+    }
+    return fallback;
+}
+
+int main(int argc, char **argv)
+{
+    bench_config config;
+    config.seed = bench_option(argc, argv, "seed", 1);
+    config.lines = bench_option(argc, argv, "lines", 20000);
+    config.key_min = bench_option(argc, argv, "key_min", 4);
+    config.key_max = bench_option(argc, argv, "key_max", 24);
+    config.value_min = bench_option(argc, argv, "value_min", 1);
+    config.value_max = bench_option(argc, argv, "value_max", 64);
+    config.section = bench_option(argc, argv, "section", 200);
+    config.quote = bench_option(argc, argv, "quote", 10);
+    config.number = bench_option(argc, argv, "number", 10);
+    config.comment = bench_option(argc, argv, "comment", 5);
+    config.lookups = bench_option(argc, argv, "lookups", 256);
+    config.min_ms = bench_option(argc, argv, "min_ms", 200);
+    size_t primitives = bench_option(argc, argv, "primitives", 1);
+
+    if (config.lookups == 0 || config.value_max > 4000 || config.key_max > 4000)
+    {
+        fprintf(stderr, "bench: lookups must be non zero and keys and values at most 4000 bytes\n");
+        return 1;
+    }
+
+    bench_corpus corpus;
+    if (!bench_generate(&config, &corpus))
+    {
+        fprintf(stderr, "bench: could not generate corpus\n");
+        return 1;
+    }
+
+    /* Corpus on disk for the FILE based engines */
+    FILE *file = fopen(BENCH_CORPUS_PATH, "w+b");
+    if (file == NULL || fwrite(corpus.data, 1, corpus.size, file) != corpus.size || fflush(file) != 0)
+    {
+        fprintf(stderr, "bench: could not write %s\n", BENCH_CORPUS_PATH);
+        return 1;
+    }
+
+    printf("variant=%s corpus_bytes=%zu lines=%zu keys=%zu sections=%zu seed=%lu lookups=%zu\n", BENCH_VARIANT, corpus.size, config.lines, corpus.keys, corpus.sections, config.seed,
+           config.lookups);
+
+    /* Mutable copy for the buffer engine */
+    char *copy = malloc(corpus.size + 1);
+    memcpy(copy, corpus.data, corpus.size + 1);
+
+    size_t index_bytes = KV_PARSE_INDEX_BYTES(corpus.keys);
+    void *index_storage = malloc(index_bytes);
+    kv_parse_index index;
+    kv_parse_index_init(&index, index_storage, corpus.keys);
+
+    kv_parse_section *dir_storage = malloc((corpus.sections + 1) * sizeof(kv_parse_section));
+    kv_parse_sections dir;
+    kv_parse_sections_init(&dir, dir_storage, corpus.sections + 1);
+
+    kv_parse_map map;
+    if (!kv_parse_map_open(&map, BENCH_CORPUS_PATH))
+    {
+        fprintf(stderr, "bench: could not map %s\n", BENCH_CORPUS_PATH);
+        return 1;
+    }
+
+    /* Corpus mtime in the past, so sidecar loads are outside the window where the content hash is checked */
+    struct timespec times[2] = {{0, UTIME_OMIT}, {time(NULL) - 60, 0}};
+    utimensat(AT_FDCWD, BENCH_CORPUS_PATH, times, 0);
+
+    /* Compiled image, also on disk for the startup timing */
+    size_t image_max = kv_parse_kvc_compile(corpus.data, NULL, 0);
+    unsigned char *image = malloc(image_max);
+    size_t image_size = kv_parse_kvc_compile(corpus.data, image, image_max);
+    FILE *image_file = fopen(BENCH_IMAGE_PATH, "wb");
+    if (image_size == 0 || image_file == NULL || fwrite(image, 1, image_size, image_file) != image_size || fclose(image_file) != 0)
+    {
+        fprintf(stderr, "bench: could not write %s\n", BENCH_IMAGE_PATH);
+        return 1;
+    }
+
+    kv_parse_kvc kvc;
+    kv_parse_kvc_bind(&kvc, image, image_size);
+
+#ifdef __linux__
+    static kv_parse_live live;
+    if (!kv_parse_live_open(&live, BENCH_CORPUS_PATH))
+    {
+        fprintf(stderr, "bench: could not watch %s\n", BENCH_CORPUS_PATH);
+        return 1;
+    }
+#endif
+
+    /* Line offsets and key tags for every line, about two bytes each */
+    kv_parse_lines lines;
+    unsigned char *lines_storage = malloc(4 * config.lines + 64);
+    kv_parse_lines_init(&lines, lines_storage, 4 * config.lines + 64, 1);
+
+    /* Bloom filter at 10 bits per key */
+    kv_parse_bloom bloom;
+    kv_parse_bloom_init(&bloom, malloc(KV_PARSE_BLOOM_BYTES(corpus.keys)), KV_PARSE_BLOOM_BYTES(corpus.keys));
+
+    bench_ctx ctx;
+    ctx.config = &config;
+    ctx.corpus = &corpus;
+    ctx.file = file;
+    ctx.copy = copy;
+    ctx.index = &index;
+    ctx.dir = &dir;
+    ctx.map = &map;
+    ctx.kvc = &kvc;
+#ifdef __linux__
+    ctx.live = &live;
+#endif
+    ctx.offsets = &lines;
+    ctx.bloom = &bloom;
+    ctx.image = malloc(image_max);
+    ctx.image_max = image_max;
+
+    /* Full scans. A missing key forces a pass over every line */
+    bench_report_scan("file", "scan_miss", bench_time(bench_file_miss, &ctx), corpus.size);
+    bench_report_scan("reader", "scan_miss", bench_time(bench_reader_miss, &ctx), corpus.size);
+    bench_report_scan("pread", "scan_miss", bench_time(bench_pread_miss, &ctx), corpus.size);
+    bench_report_scan("buffer", "scan_miss", bench_time(bench_buffer_miss, &ctx), corpus.size);
+    bench_report_scan("span", "scan_miss", bench_time(bench_span_miss, &ctx), corpus.size);
+    bench_report_scan("iter", "scan", bench_time(bench_iter_scan, &ctx), corpus.size);
+    bench_report_scan("stream", "scan", bench_time(bench_stream_scan, &ctx), corpus.size);
+    bench_report_scan("index", "build", bench_time(bench_index_build, &ctx), corpus.size);
+    bench_report_scan("index_parallel", "build", bench_time(bench_index_parallel_build, &ctx), corpus.size);
+    bench_report_scan("sections", "build", bench_time(bench_sections_build, &ctx), corpus.size);
+    bench_report_scan("kvc", "build", bench_time(bench_kvc_build, &ctx), corpus.size);
+    bench_report_scan("kvidx", "build", bench_time(bench_kvidx_build, &ctx), corpus.size);
+#ifdef __linux__
+    bench_report_scan("live", "reload", bench_time(bench_live_reload, &ctx), corpus.size);
+#endif
+
+    /* Lookups of keys spread over the corpus */
+    bench_report_lookup("file", "lookup", bench_time(bench_file_lookup, &ctx), 1);
+    bench_report_lookup("lines", "lookup", bench_time(bench_lines_lookup, &ctx), 1);
+    bench_report_lookup("reader", "lookup", bench_time(bench_reader_lookup, &ctx), 1);
+    bench_report_lookup("pread", "lookup", bench_time(bench_pread_lookup, &ctx), 1);
+    bench_report_lookup("buffer", "lookup", bench_time(bench_buffer_lookup, &ctx), 1);
+    bench_report_lookup("span", "lookup", bench_time(bench_span_lookup, &ctx), 1);
+    bench_report_lookup("map", "lookup", bench_time(bench_map_lookup, &ctx), 1);
+    bench_report_lookup("get_many", "lookup", bench_time(bench_get_many, &ctx), config.lookups < 64 ? config.lookups : 64);
+    kv_parse_buffer_index(&index, copy);
+    bench_report_lookup("index", "lookup", bench_time(bench_index_lookup, &ctx), 1);
+    bench_report_scan("bloom", "build", bench_time(bench_bloom_build, &ctx), corpus.size);
+    bench_absent_init();
+    bench_report_lookup("bloom", "check_miss", bench_time(bench_bloom_miss, &ctx), 1);
+    bench_report_lookup("bloom_file", "lookup_miss", bench_time(bench_bloom_file_miss, &ctx), 1);
+    printf("variant=%s engine=bloom op=false_positive keys=%zu bits_per_key=%.1f rate=%.4f\n", BENCH_VARIANT, bloom.count, (double)bloom.bit_count / (double)bloom.count,
+           bench_bloom_false_positive_rate(&bloom, 100000));
+    kv_parse_buffer_sections(&dir, corpus.data);
+    bench_report_lookup("sections", "lookup", bench_time(bench_sections_lookup, &ctx), 1);
+    bench_report_lookup("kvc", "lookup", bench_time(bench_kvc_lookup, &ctx), 1);
+#ifdef __linux__
+    bench_report_lookup("live", "lookup", bench_time(bench_live_lookup, &ctx), 1);
+#endif
+
+    /* Start of a line by number. The table was filled by the lookups above */
+    bench_report_lookup("file", "seek", bench_time(bench_file_seek, &ctx), 1);
+    bench_report_lookup("lines", "seek", bench_time(bench_lines_seek, &ctx), 1);
+
+    /* Open, one lookup and close, as done once per process start */
+    bench_report_lookup("map", "startup", bench_time(bench_map_startup, &ctx), 1);
+    bench_report_lookup("kvc", "startup", bench_time(bench_kvc_startup, &ctx), 1);
+    bench_report_lookup("kvidx", "startup", bench_time(bench_kvidx_startup, &ctx), 1);
+
+    if (primitives)
+    {
+        /* Each primitive on its own, over the lines it applies to */
+        bench_counters counters;
+        bench_counters_open(&counters);
+        memcpy(copy, corpus.data, corpus.size + 1);
+        bench_primitives_prepare(&ctx);
+        bench_primitive("buffer_next_line", bench_buffer_next_line, &ctx, &ctx.lines, &counters);
+        bench_primitive("buffer_check_key_hit", bench_buffer_check_key_hit, &ctx, &ctx.keys, &counters);
+        bench_primitive("buffer_check_key_miss", bench_buffer_check_key_miss, &ctx, &ctx.keys, &counters);
+        bench_primitive("buffer_match_key_hit", bench_buffer_match_key_hit, &ctx, &ctx.keys, &counters);
+        bench_primitive("buffer_match_key_miss", bench_buffer_match_key_miss, &ctx, &ctx.keys, &counters);
+        bench_primitive("buffer_get_value_plain", bench_buffer_get_value_plain, &ctx, &ctx.plain_values, &counters);
+        bench_primitive("buffer_get_value_quoted", bench_buffer_get_value_quoted, &ctx, &ctx.quoted_values, &counters);
+        bench_primitive("buffer_get_value_strtoll", bench_buffer_get_value_strtoll, &ctx, &ctx.number_values, &counters);
+        bench_primitive("buffer_get_i64", bench_buffer_get_i64, &ctx, &ctx.number_values, &counters);
+        bench_primitive("buffer_check_section", bench_buffer_check_section, &ctx, &ctx.headers, &counters);
+        bench_primitive("file_next_line", bench_file_next_line, &ctx, &ctx.lines, &counters);
+        bench_primitive("file_check_key_hit", bench_file_check_key_hit, &ctx, &ctx.keys, &counters);
+        bench_primitive("file_check_key_miss", bench_file_check_key_miss, &ctx, &ctx.keys, &counters);
+        bench_primitive("file_get_value_plain", bench_file_get_value_plain, &ctx, &ctx.plain_values, &counters);
+        bench_primitive("file_get_value_quoted", bench_file_get_value_quoted, &ctx, &ctx.quoted_values, &counters);
+        bench_primitive("file_check_section", bench_file_check_section, &ctx, &ctx.headers, &counters);
+        bench_counters_close(&counters);
+    }
+
+    kv_parse_map_close(&map);
+#ifdef __linux__
+    kv_parse_live_close(&live);
+#endif
+    fclose(file);
+    remove(BENCH_CORPUS_PATH);
+    remove(BENCH_IMAGE_PATH);
+    remove(BENCH_CORPUS_PATH KV_PARSE_KVIDX_SUFFIX);
+    return 0;
+}
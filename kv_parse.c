@@ -8,8 +8,13 @@
  * Copyright (c) 2025 Brian Khuu
  * MIT licensed
  */
+#include "kv_parse.h"
+#include "kv_parse_class.h"
+#include "kv_parse_key.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 bool kv_parse_next_line(FILE *file, size_t line_count)
 {
@@ -51,7 +56,7 @@ bool kv_parse_check_key(FILE *file, const char *key)
     int ch = getc(file);
 
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-    while (ch == ' ' || ch == '\t')
+    while (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_SPACE))
     {
         ch = getc(file);
     }
@@ -69,14 +74,14 @@ bool kv_parse_check_key(FILE *file, const char *key)
     }
 
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-    while (ch == ' ' || ch == '\t')
+    while (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_SPACE))
     {
         ch = getc(file);
     }
 #endif
 
     /* Check For Key Value Delimiter */
-    if (ch != '=' && ch != ':')
+    if (!KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_DELIMITER))
     {
         fseek(file, start_of_line, SEEK_SET);
         return false;
@@ -86,12 +91,118 @@ bool kv_parse_check_key(FILE *file, const char *key)
     return true;
 }
 
+bool kv_parse_match_key(FILE *file, const kv_key *key)
+{
+    long start_of_line = ftell(file);
+    int ch = getc(file);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_SPACE))
+    {
+        ch = getc(file);
+    }
+#endif
+
+    if (ch == EOF)
+    {
+        fseek(file, start_of_line, SEEK_SET);
+        return false;
+    }
+    ungetc(ch, file);
+
+    /* Check For Key. Compared a block at a time */
+    char block[64];
+    for (size_t i = 0; i < key->len; i += sizeof(block))
+    {
+        size_t len = (key->len - i < sizeof(block)) ? key->len - i : sizeof(block);
+        if (fread(block, 1, len, file) != len || memcmp(block, key->str + i, len) != 0)
+        {
+            /* End of string. Key was not found */
+            fseek(file, start_of_line, SEEK_SET);
+            return false;
+        }
+    }
+    ch = getc(file);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_SPACE))
+    {
+        ch = getc(file);
+    }
+#endif
+
+    /* Check For Key Value Delimiter */
+    if (!KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_DELIMITER))
+    {
+        fseek(file, start_of_line, SEEK_SET);
+        return false;
+    }
+
+    /* Key Found. Next position is likely the value */
+    return true;
+}
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+static int kv_parse_hex_digit(int ch)
+{
+    if (ch >= '0' && ch <= '9')
+    {
+        return ch - '0';
+    }
+    else if (ch >= 'a' && ch <= 'f')
+    {
+        return ch - 'a' + 10;
+    }
+    else if (ch >= 'A' && ch <= 'F')
+    {
+        return ch - 'A' + 10;
+    }
+    return -1;
+}
+
+/* Reads the escape sequence following a backslash. Returns the decoded byte, or the backslash if it is literal */
+static char kv_parse_escape(FILE *file)
+{
+    long start_of_escape = ftell(file);
+    int ch = getc(file);
+    switch (ch)
+    {
+        case '\\':
+        case '"':
+        case '\'':
+            return (char)ch;
+        case 'n':
+            return '\n';
+        case 't':
+            return '\t';
+        case 'r':
+            return '\r';
+        case '0':
+            return '\0';
+        case 'x':
+        {
+            int high = kv_parse_hex_digit(getc(file));
+            int low = kv_parse_hex_digit(getc(file));
+            if (high >= 0 && low >= 0)
+            {
+                return (char)(high * 16 + low);
+            }
+            break;
+        }
+    }
+
+    /* Not An Escape. Keep the backslash and reread what followed it */
+    fseek(file, start_of_escape, SEEK_SET);
+    return '\\';
+}
+#endif
+
 size_t kv_parse_get_value(FILE *file, char *value, size_t value_max)
 {
     long start_of_value = ftell(file);
     int ch = getc(file);
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-    while (ch == ' ' || ch == '\t')
+    while (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_SPACE))
     {
         ch = getc(file);
     }
@@ -100,11 +211,10 @@ size_t kv_parse_get_value(FILE *file, char *value, size_t value_max)
     /* Copy Value To Buffer */
 #ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
     int quote = EOF;
-    int prev = EOF;
 #endif
     for (int i = 0; i < (value_max - 1); ch = getc(file))
     {
-        if (ch == EOF || ch == '\r' || ch == '\n')
+        if (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_EOF | KV_PARSE_CLASS_EOL))
         {
             /* End Of Line */
             fseek(file, start_of_value, SEEK_SET);
@@ -114,7 +224,7 @@ size_t kv_parse_get_value(FILE *file, char *value, size_t value_max)
             }
             value[i] = '\0';
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-            while (i > 0 && (value[i - 1] == ' ' || value[i - 1] == '\t'))
+            while (i > 0 && KV_PARSE_IS(value[i - 1], KV_PARSE_CLASS_SPACE))
             {
                 i--;
                 value[i] = '\0';
@@ -123,27 +233,25 @@ size_t kv_parse_get_value(FILE *file, char *value, size_t value_max)
             return i;
         }
 #ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
-        else if (quote == EOF && (ch == '\'' || ch == '"'))
+        else if (quote == EOF && KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_QUOTE))
         {
             /* Start Of Quoted String */
             quote = ch;
             continue;
         }
-        else if (quote != EOF && prev != '\\' && ch == quote)
+        else if (quote != EOF && ch == quote)
         {
             /* End Of Quoted String. Return Value */
             fseek(file, start_of_value, SEEK_SET);
             value[i] = '\0';
             return i;
         }
-        else if (quote != EOF && prev == '\\' && ch == quote)
+        else if (quote != EOF && ch == '\\')
         {
-            /* Escaped Character In Quoted String */
-            value[i - 1] = ch == EOF ? '\0' : ch;
+            /* Escape Sequence In Quoted String */
+            value[i++] = kv_parse_escape(file);
             continue;
         }
-
-        prev = ch;
 #endif
 
         value[i++] = ch == EOF ? '\0' : ch;
@@ -173,12 +281,12 @@ size_t kv_parse_check_section(FILE *file, char *section, size_t section_max)
     for (int i = 0; i < (section_max - 1); ch = getc(file))
     {
         /* Check For INI/TOML Section Closing Delimiter */
-        if (ch == EOF || ch == '\r' || ch == '\n')
+        if (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_EOF | KV_PARSE_CLASS_EOL))
         {
             /* End Of Line (Scan for closing bracket)*/
             fseek(file, start_of_line, SEEK_SET);
             section[i] = '\0';
-            while (i > 0 && (section[i - 1] == ' ' || section[i - 1] == '\t'))
+            while (i > 0 && KV_PARSE_IS(section[i - 1], KV_PARSE_CLASS_SPACE))
             {
                 i--;
                 section[i] = '\0';
@@ -206,3 +314,112 @@ size_t kv_parse_check_section(FILE *file, char *section, size_t section_max)
     section[0] = '\0';
     return 0;
 }
+
+size_t kv_parse_get_many(FILE *file, kv_parse_query *queries, size_t query_count)
+{
+    /* Build first byte and key hash filters over all queries */
+    uint32_t first_bytes[8] = {0};
+    uint32_t key_hashes[KV_PARSE_GET_MANY_FILTER_BITS / 32] = {0};
+    for (size_t q = 0; q < query_count; q++)
+    {
+        unsigned char first = (unsigned char)queries[q].key[0];
+        uint32_t hash = kv_parse_key_hash(queries[q].key, strlen(queries[q].key)) % KV_PARSE_GET_MANY_FILTER_BITS;
+        first_bytes[first >> 5] |= (uint32_t)1 << (first & 31);
+        key_hashes[hash >> 5] |= (uint32_t)1 << (hash & 31);
+        queries[q].found = false;
+        queries[q].value_len = 0;
+    }
+
+    rewind(file);
+
+    size_t found = 0;
+    for (size_t line = 0; found < query_count && kv_parse_next_line(file, line); line++)
+    {
+        char key[KV_PARSE_GET_MANY_KEY_MAX];
+        size_t key_len = 0;
+        int ch = getc(file);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_SPACE))
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Reject line if no query starts with this byte */
+        if (ch == EOF || (first_bytes[(unsigned char)ch >> 5] & ((uint32_t)1 << (ch & 31))) == 0)
+        {
+            /* Leave any newline for kv_parse_next_line() */
+            ungetc(ch, file);
+            continue;
+        }
+
+        /* Read Key Up To Key Value Delimiter */
+        while (!KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_EOF | KV_PARSE_CLASS_LINE_FEED | KV_PARSE_CLASS_DELIMITER) && key_len < sizeof(key))
+        {
+            key[key_len++] = (char)ch;
+            ch = getc(file);
+        }
+
+        if (!KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_DELIMITER))
+        {
+            ungetc(ch, file);
+            continue;
+        }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (key_len > 0 && KV_PARSE_IS(key[key_len - 1], KV_PARSE_CLASS_SPACE))
+        {
+            key_len--;
+        }
+#endif
+
+        /* Reject line if no query has this key hash */
+        uint32_t hash = kv_parse_key_hash(key, key_len) % KV_PARSE_GET_MANY_FILTER_BITS;
+        if ((key_hashes[hash >> 5] & ((uint32_t)1 << (hash & 31))) == 0)
+        {
+            continue;
+        }
+
+        /* Check For Key */
+        long start_of_value = -1;
+        for (size_t q = 0; q < query_count; q++)
+        {
+            if (queries[q].found || strncmp(queries[q].key, key, key_len) != 0 || queries[q].key[key_len] != '\0')
+            {
+                continue;
+            }
+
+            /* Same key queried more than once. Return to the value for each */
+            if (start_of_value < 0)
+            {
+                start_of_value = ftell(file);
+            }
+            else
+            {
+                fseek(file, start_of_value, SEEK_SET);
+            }
+
+            /* Key Found. Extract value and keep scanning for any other query with the same key */
+            queries[q].value_len = kv_parse_get_value(file, queries[q].value, queries[q].value_max);
+            queries[q].found = true;
+            found++;
+        }
+
+        /* Value was read. Skip the rest of the line so the value is not parsed as a line of its own */
+        if (start_of_value >= 0)
+        {
+            fseek(file, start_of_value, SEEK_SET);
+            while (ch != EOF && ch != '\n')
+            {
+                ch = getc(file);
+            }
+            if (ch == '\n')
+            {
+                ungetc(ch, file);
+            }
+        }
+    }
+
+    return found;
+}
@@ -22,10 +22,33 @@
 #ifndef KV_PARSE_H
 #define KV_PARSE_H
 
+#include "kv_parse_key.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 
+/* Longest key supported by `kv_parse_get_many()` */
+#ifndef KV_PARSE_GET_MANY_KEY_MAX
+#define KV_PARSE_GET_MANY_KEY_MAX 128
+#endif
+
+/* Bits in the key hash filter used by `kv_parse_get_many()` to reject lines */
+#ifndef KV_PARSE_GET_MANY_FILTER_BITS
+#define KV_PARSE_GET_MANY_FILTER_BITS 2048
+#endif
+
+/**
+ * @brief One key lookup in a `kv_parse_get_many()` batch.
+ */
+typedef struct kv_parse_query
+{
+    const char *key;  /* Key to search for */
+    char *value;      /* Buffer to store the extracted value */
+    size_t value_max; /* Maximum size of the value buffer */
+    size_t value_len; /* Output: Length of the extracted value */
+    bool found;       /* Output: true if the key was found */
+} kv_parse_query;
+
 /**
  * @brief Advances the file stream to the next line.
  *
@@ -56,6 +79,19 @@ bool kv_parse_next_line(FILE *file, size_t line_count);
  */
 bool kv_parse_check_key(FILE *file, const char *key);
 
+/**
+ * @brief Checks if the current line contains the key described by a key descriptor.
+ *
+ * Same as `kv_parse_check_key()` but the key is read a block at a time with `fread()` and
+ * compared with `memcmp()` instead of one `getc()` per key byte.
+ *
+ * @param file Pointer to an open file stream.
+ * @param key Key descriptor built with `KV_PARSE_KEY()` or `kv_parse_key()`.
+ *
+ * @return true if the key is found, false otherwise.
+ */
+bool kv_parse_match_key(FILE *file, const kv_key *key);
+
 /**
  * @brief Extracts the value associated with a key from a file stream.
  *
@@ -70,7 +106,8 @@ bool kv_parse_check_key(FILE *file, const char *key);
  *
  * @note If KV_PARSE_WHITESPACE_SKIP is defined, leading and trailing whitespace is trimmed.
  * @note If KV_PARSE_QUOTED_STRINGS is defined, quoted values are supported, allowing
- *       values to be enclosed in single or double quotes.
+ *       values to be enclosed in single or double quotes. Escapes inside quotes are decoded:
+ *       \\ \" \' \n \t \r \0 and \xHH. Other backslashes are kept as is.
  */
 size_t kv_parse_get_value(FILE *file, char *value, size_t value_max);
 
@@ -89,4 +126,22 @@ size_t kv_parse_get_value(FILE *file, char *value, size_t value_max);
  */
 size_t kv_parse_check_section(FILE *file, char *section, size_t section_max);
 
+/**
+ * @brief Extracts the values of many keys in a single pass over the file stream.
+ *
+ * The file is rewound once and each line is matched against every query at once. Lines are first
+ * filtered by the first byte and a hash of their key so most lines are rejected without
+ * comparing any key or seeking. Scanning stops as soon as every query is found.
+ * Duplicate keys return the first occurrence.
+ *
+ * @param file Pointer to the file stream.
+ * @param queries Array of queries. `found` and `value_len` are filled in for each query.
+ * @param query_count Number of queries.
+ *
+ * @return The number of queries found.
+ *
+ * @note Keys longer than KV_PARSE_GET_MANY_KEY_MAX are never found.
+ */
+size_t kv_parse_get_many(FILE *file, kv_parse_query *queries, size_t query_count);
+
 #endif
@@ -0,0 +1,204 @@
+/**
+ * @file kv_parse_bloom.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a Bloom filter over the keys of an input. Each key is hashed once and the
+ * bit positions are derived from two mixes of that hash (double hashing).
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#include "kv_parse_bloom.h"
+#include "kv_parse_buffer.h"
+#include "kv_parse_class.h"
+#include "kv_parse_index.h"
+#include "kv_parse_key.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Largest bit array addressable with 32 bit positions */
+#define KV_PARSE_BLOOM_MAX_BYTES ((size_t)1 << 29)
+
+/* Maps a 32 bit value onto the bit array without a division */
+static uint32_t kv_parse_bloom_bit(const kv_parse_bloom *bloom, uint32_t hash)
+{
+    return (uint32_t)(((uint64_t)hash * bloom->bit_count) >> 32);
+}
+
+static void kv_parse_bloom_add_hash(kv_parse_bloom *bloom, uint32_t hash)
+{
+    if (bloom->bit_count == 0)
+    {
+        return;
+    }
+
+    uint32_t h1 = kv_parse_key_mix(hash);
+    uint32_t h2 = kv_parse_key_mix(hash + 0x9E3779B9u) | 1;
+
+    for (unsigned int i = 0; i < KV_PARSE_BLOOM_HASHES; i++, h1 += h2)
+    {
+        uint32_t bit = kv_parse_bloom_bit(bloom, h1);
+        bloom->bits[bit >> 3] |= (unsigned char)(1u << (bit & 7));
+    }
+    bloom->count++;
+}
+
+static bool kv_parse_bloom_check_hash(const kv_parse_bloom *bloom, uint32_t hash)
+{
+    if (bloom->bit_count == 0)
+    {
+        /* No storage. Nothing can be rejected */
+        return true;
+    }
+
+    uint32_t h1 = kv_parse_key_mix(hash);
+    uint32_t h2 = kv_parse_key_mix(hash + 0x9E3779B9u) | 1;
+
+    for (unsigned int i = 0; i < KV_PARSE_BLOOM_HASHES; i++, h1 += h2)
+    {
+        uint32_t bit = kv_parse_bloom_bit(bloom, h1);
+        if (!(bloom->bits[bit >> 3] & (1u << (bit & 7))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void kv_parse_bloom_init(kv_parse_bloom *bloom, void *storage, size_t storage_size)
+{
+    if (storage_size > KV_PARSE_BLOOM_MAX_BYTES)
+    {
+        storage_size = KV_PARSE_BLOOM_MAX_BYTES;
+    }
+
+    bloom->bits = (unsigned char *)storage;
+    bloom->bit_count = (uint32_t)(storage_size * 8 > UINT32_MAX ? UINT32_MAX : storage_size * 8);
+    bloom->count = 0;
+    if (storage_size > 0)
+    {
+        memset(bloom->bits, 0, storage_size);
+    }
+}
+
+void kv_parse_bloom_add(kv_parse_bloom *bloom, const char *key, size_t key_len)
+{
+    kv_parse_bloom_add_hash(bloom, kv_parse_key_hash(key, key_len));
+}
+
+bool kv_parse_bloom_check(const kv_parse_bloom *bloom, const char *key)
+{
+    return kv_parse_bloom_check_hash(bloom, kv_parse_key_hash(key, strlen(key)));
+}
+
+bool kv_parse_bloom_check_key(const kv_parse_bloom *bloom, const kv_key *key)
+{
+    return kv_parse_bloom_check_hash(bloom, key->hash);
+}
+
+void kv_parse_index_bloom(kv_parse_bloom *bloom, const kv_parse_index *index)
+{
+    for (size_t entry = 0; entry < index->count; entry++)
+    {
+        kv_parse_bloom_add(bloom, index->buffer + index->key_offset[entry], index->key_len[entry]);
+    }
+}
+
+/* Adds every key `kv_parse_buffer_check_key()` would match on one line */
+static void kv_parse_bloom_add_line(kv_parse_bloom *bloom, const char *line, const char *eol)
+{
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    line = kv_parse_buffer_skip_whitespace((char *)line);
+#endif
+
+    /* A key may end at any delimiter on the line, including ones inside the value */
+    for (const char *delimiter = line; delimiter < eol; delimiter++)
+    {
+        if (!KV_PARSE_IS(*delimiter, KV_PARSE_CLASS_DELIMITER))
+        {
+            continue;
+        }
+
+        const char *end = delimiter;
+        kv_parse_bloom_add(bloom, line, (size_t)(end - line));
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        /* Whitespace before the delimiter may or may not be part of the key */
+        while (end > line && KV_PARSE_IS(end[-1], KV_PARSE_CLASS_SPACE))
+        {
+            end--;
+            kv_parse_bloom_add(bloom, line, (size_t)(end - line));
+        }
+#endif
+    }
+}
+
+void kv_parse_buffer_bloom(kv_parse_bloom *bloom, const char *str)
+{
+    while (*str != '\0')
+    {
+        const char *eol = kv_parse_buffer_scan_line((char *)str);
+        kv_parse_bloom_add_line(bloom, str, eol);
+        str = (*eol == '\n') ? eol + 1 : eol;
+    }
+}
+
+bool kv_parse_file_bloom(kv_parse_bloom *bloom, FILE *file, char *block, size_t block_size)
+{
+    size_t used = 0;
+    bool complete = block_size > 1;
+
+    rewind(file);
+    while (complete)
+    {
+        /* Top up the block, leaving room for a terminator */
+        size_t count = fread(block + used, 1, block_size - 1 - used, file);
+        bool last = used + count < block_size - 1;
+        used += count;
+
+        /* A null byte would end the scan of the block early */
+        if (memchr(block, '\0', used) != NULL)
+        {
+            complete = false;
+            break;
+        }
+
+        /* Scan the complete lines. The unfinished line is kept for the next block */
+        size_t lines = used;
+        if (!last)
+        {
+            while (lines > 0 && block[lines - 1] != '\n')
+            {
+                lines--;
+            }
+            if (lines == 0)
+            {
+                /* Line longer than the block */
+                complete = false;
+                break;
+            }
+        }
+
+        char keep = block[lines];
+        block[lines] = '\0';
+        kv_parse_buffer_bloom(bloom, block);
+        block[lines] = keep;
+
+        if (last)
+        {
+            break;
+        }
+        memmove(block, block + lines, used - lines);
+        used -= lines;
+    }
+    rewind(file);
+
+    if (!complete && bloom->bit_count > 0)
+    {
+        /* Keys were missed. Never reject */
+        memset(bloom->bits, 0xFF, ((size_t)bloom->bit_count + 7) / 8);
+    }
+    return complete;
+}
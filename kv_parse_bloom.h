@@ -0,0 +1,139 @@
+/**
+ * @file kv_parse_bloom.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a Bloom filter over the keys of an input. It is filled once from an index,
+ * a buffer or a FILE, after which a key that is not present is usually rejected with a few bit
+ * tests instead of a scan to the end of the input. A "maybe present" answer is wrong for a small
+ * fraction of missing keys (about 1% at the KV_PARSE_BLOOM_BYTES() size) and needs a normal lookup
+ * to confirm. A "not present" answer holds for the lookups that match the filled keys: the
+ * check_key and get engines for a buffer or FILE filled filter, the index for an index filled one.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * static unsigned char storage[KV_PARSE_BLOOM_BYTES(256)];
+ * static char block[4096];
+ * kv_parse_bloom bloom;
+ * kv_parse_bloom_init(&bloom, storage, sizeof(storage));
+ * kv_parse_file_bloom(&bloom, file, block, sizeof(block));
+ *
+ * if (!kv_parse_bloom_check(&bloom, key))
+ * {
+ *     return 0;
+ * }
+ * return kv_parse(file, key, value, value_max);
+ * @endcode
+ */
+#ifndef KV_PARSE_BLOOM_H
+#define KV_PARSE_BLOOM_H
+
+#include "kv_parse_index.h"
+#include "kv_parse_key.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Bits set per key. 7 is the best count for 10 bits per key */
+#ifndef KV_PARSE_BLOOM_HASHES
+#define KV_PARSE_BLOOM_HASHES 7
+#endif
+
+/* Storage size in bytes for n keys at 10 bits per key, about a 1% false positive rate */
+#define KV_PARSE_BLOOM_BYTES(n) (((n) * 10 + 7) / 8 + 1)
+
+/**
+ * @brief Bloom filter over keys, in caller supplied storage.
+ */
+typedef struct kv_parse_bloom
+{
+    unsigned char *bits;
+    uint32_t bit_count;
+    size_t count; /* Keys added */
+} kv_parse_bloom;
+
+/**
+ * @brief Binds an empty filter to caller supplied storage.
+ *
+ * @param bloom Filter to initialise.
+ * @param storage Storage for the bit array. Cleared by this call.
+ * @param storage_size Size of the storage in bytes. At most 512 MiB is used.
+ */
+void kv_parse_bloom_init(kv_parse_bloom *bloom, void *storage, size_t storage_size);
+
+/**
+ * @brief Adds a key to the filter.
+ *
+ * @param bloom Filter bound with `kv_parse_bloom_init()`.
+ * @param key Key, not necessarily null terminated.
+ * @param key_len Length of the key.
+ */
+void kv_parse_bloom_add(kv_parse_bloom *bloom, const char *key, size_t key_len);
+
+/**
+ * @brief Checks whether a key may be present.
+ *
+ * @param bloom Filter filled with the keys of the input.
+ * @param key The key to check.
+ *
+ * @return false if the key is definitely not in the input, true if it may be.
+ */
+bool kv_parse_bloom_check(const kv_parse_bloom *bloom, const char *key);
+
+/**
+ * @brief Checks whether a key described by a key descriptor may be present.
+ *
+ * Same as `kv_parse_bloom_check()` but the key length and hash come from the descriptor.
+ *
+ * @param bloom Filter filled with the keys of the input.
+ * @param key Key descriptor built with `KV_PARSE_KEY()` or `kv_parse_key()`.
+ *
+ * @return false if the key is definitely not in the input, true if it may be.
+ */
+bool kv_parse_bloom_check_key(const kv_parse_bloom *bloom, const kv_key *key);
+
+/**
+ * @brief Adds every key of an index to the filter, without rescanning the buffer.
+ *
+ * Keys are split at the first delimiter and trimmed, as `kv_parse_index_get()` looks them up.
+ * A key such as "db:host" that only `kv_parse_buffer_check_key()` matches is not added, so
+ * use this filter in front of the index only.
+ *
+ * @param bloom Filter bound with `kv_parse_bloom_init()`.
+ * @param index Index filled by `kv_parse_buffer_index()` that covers the whole buffer.
+ */
+void kv_parse_index_bloom(kv_parse_bloom *bloom, const kv_parse_index *index);
+
+/**
+ * @brief Adds every key of a buffer to the filter.
+ *
+ * Every key that `kv_parse_buffer_check_key()` or `kv_parse_check_key()` would match is added, in
+ * every section: the text before each delimiter on a line, with and without the whitespace in front
+ * of the delimiter. "db:host=localhost" adds "db", "db:host" and "db:host=localhost". Keys spanning
+ * a line end are not covered. Size the storage for the delimiters per line, not just the lines.
+ *
+ * @param bloom Filter bound with `kv_parse_bloom_init()`.
+ * @param str Buffer to scan.
+ */
+void kv_parse_buffer_bloom(kv_parse_bloom *bloom, const char *str);
+
+/**
+ * @brief Adds every key of a file stream to the filter in one pass.
+ *
+ * Keys follow the same rules as `kv_parse_buffer_bloom()`. The file is rewound and read a block at
+ * a time with `fread()`, and rewound again at the end.
+ *
+ * @param bloom Filter bound with `kv_parse_bloom_init()`.
+ * @param file Pointer to the file stream.
+ * @param block Scratch buffer for one block.
+ * @param block_size Size of the block. Lines must be shorter than the block.
+ *
+ * @return true if every line was read. false if a line did not fit in the block or the file holds a
+ *         null byte, in which case every bit is set so no key is rejected.
+ */
+bool kv_parse_file_bloom(kv_parse_bloom *bloom, FILE *file, char *block, size_t block_size);
+
+#endif
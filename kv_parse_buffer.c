@@ -8,8 +8,371 @@
  * Copyright (c) 2025 Brian Khuu
  * MIT licensed
  */
+#include "kv_parse_buffer.h"
+#include "kv_parse_class.h"
+#include "kv_parse_key.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Vectorized scan kernels need GCC/Clang on x86 for intrinsics, target attributes and cpu detection */
+#if !defined(KV_PARSE_DISABLE_SIMD) && !defined(KV_PARSE_SCAN_FORCE_PORTABLE) && defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define KV_PARSE_SCAN_X86
+#include <immintrin.h>
+
+/* Kernels read whole aligned blocks around the string. An aligned block never crosses a page so this
+ * is safe, but address sanitizer cannot tell. */
+#if defined(__clang__) || __GNUC__ >= 5
+#define KV_PARSE_SCAN_KERNEL __attribute__((no_sanitize_address))
+#else
+#define KV_PARSE_SCAN_KERNEL
+#endif
+#endif
+
+/* Key words are compared with unaligned 8 byte loads kept within one page. The loads may read past
+ * the terminator, so they are only used when KV_PARSE_ENABLE_KEY_OVERREAD is defined */
+#if defined(KV_PARSE_ENABLE_KEY_OVERREAD) && !defined(KV_PARSE_DISABLE_SIMD) && defined(__GNUC__)
+#define KV_PARSE_KEY_WORDS
+#define KV_PARSE_KEY_PAGE 4096
+#if defined(__clang__) || __GNUC__ >= 5
+#define KV_PARSE_KEY_KERNEL __attribute__((no_sanitize_address))
+#else
+#define KV_PARSE_KEY_KERNEL
+#endif
+#else
+#define KV_PARSE_KEY_KERNEL
+#endif
+
+/* Scan sets. Each holds three bytes (repeated to pad) and is matched along with '\0'. The delimiter
+ * set is `kv_parse_class_delimiters`, which holds the registered delimiters after the first three */
+#define KV_PARSE_SCAN_LINE "\n\n\n"
+#define KV_PARSE_SCAN_WHITESPACE " \t\t"
+
+static const char *kv_parse_scan_portable(const char *str, const char *set, size_t extra, bool invert)
+{
+    /* libc string scans are already vectorized on most platforms. The set string holds the extra bytes */
+    (void)extra;
+    return str + (invert ? strspn(str, set) : strcspn(str, set));
+}
+
+#if defined(KV_PARSE_SCAN_X86) && !defined(KV_PARSE_SCAN_FORCE_AVX2)
+KV_PARSE_SCAN_KERNEL static const char *kv_parse_scan_sse2(const char *str, const char *set, size_t extra, bool invert)
+{
+    const __m128i a = _mm_set1_epi8(set[0]);
+    const __m128i b = _mm_set1_epi8(set[1]);
+    const __m128i c = _mm_set1_epi8(set[2]);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i more[KV_PARSE_CLASS_EXTRA_MAX];
+    for (size_t i = 0; i < extra; i++)
+    {
+        more[i] = _mm_set1_epi8(set[3 + i]);
+    }
+
+    /* Start from the aligned block holding str and ignore bytes before it */
+    size_t skip = (uintptr_t)str & 15;
+    const char *block = str - skip;
+    for (;; block += 16, skip = 0)
+    {
+        __m128i v = _mm_load_si128((const __m128i *)block);
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, a), _mm_cmpeq_epi8(v, b)), _mm_cmpeq_epi8(v, c));
+        for (size_t i = 0; i < extra; i++)
+        {
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, more[i]));
+        }
+        unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+        if (invert)
+        {
+            /* Stop on first byte outside the set. '\0' is never in a set */
+            mask = ~mask & 0xFFFF;
+        }
+        else
+        {
+            mask |= (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+        }
+
+        mask = (mask >> skip) << skip;
+        if (mask != 0)
+        {
+            return block + __builtin_ctz(mask);
+        }
+    }
+}
+#endif
+
+#if defined(KV_PARSE_SCAN_X86) && !defined(KV_PARSE_SCAN_FORCE_SSE2)
+KV_PARSE_SCAN_KERNEL __attribute__((target("avx2"))) static const char *kv_parse_scan_avx2(const char *str, const char *set, size_t extra, bool invert)
+{
+    const __m256i a = _mm256_set1_epi8(set[0]);
+    const __m256i b = _mm256_set1_epi8(set[1]);
+    const __m256i c = _mm256_set1_epi8(set[2]);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i more[KV_PARSE_CLASS_EXTRA_MAX];
+    for (size_t i = 0; i < extra; i++)
+    {
+        more[i] = _mm256_set1_epi8(set[3 + i]);
+    }
+
+    /* Start from the aligned block holding str and ignore bytes before it */
+    size_t skip = (uintptr_t)str & 31;
+    const char *block = str - skip;
+    for (;; block += 32, skip = 0)
+    {
+        __m256i v = _mm256_load_si256((const __m256i *)block);
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, a), _mm256_cmpeq_epi8(v, b)), _mm256_cmpeq_epi8(v, c));
+        for (size_t i = 0; i < extra; i++)
+        {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(v, more[i]));
+        }
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+        if (invert)
+        {
+            /* Stop on first byte outside the set. '\0' is never in a set */
+            mask = ~mask;
+        }
+        else
+        {
+            mask |= (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+        }
+
+        mask = (mask >> skip) << skip;
+        if (mask != 0)
+        {
+            return block + __builtin_ctz(mask);
+        }
+    }
+}
+#endif
+
+/* Finds the first byte of str in set, or outside it if inverted. `extra` bytes follow the first three */
+static const char *kv_parse_scan(const char *str, const char *set, size_t extra, bool invert)
+{
+#ifdef KV_PARSE_SCAN_X86
+#ifndef KV_PARSE_SCAN_FORCE_SSE2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return kv_parse_scan_avx2(str, set, extra, invert);
+    }
+#endif
+#ifndef KV_PARSE_SCAN_FORCE_AVX2
+    return kv_parse_scan_sse2(str, set, extra, invert);
+#endif
+#endif
+    return kv_parse_scan_portable(str, set, extra, invert);
+}
+
+char *kv_parse_buffer_scan_line(char *str)
+{
+    return (char *)kv_parse_scan(str, KV_PARSE_SCAN_LINE, 0, false);
+}
+
+char *kv_parse_buffer_scan_delimiter(char *str)
+{
+    return (char *)kv_parse_scan(str, kv_parse_class_delimiters, kv_parse_class_extra_delimiters, false);
+}
+
+char *kv_parse_buffer_skip_whitespace(char *str)
+{
+    /* Most keys and values have no leading whitespace */
+    if (!KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        return str;
+    }
+
+    return (char *)kv_parse_scan(str, KV_PARSE_SCAN_WHITESPACE, 0, true);
+}
+
+/* End of the line holding str, at its '\r' or '\n' or at end */
+static const char *kv_parse_line_end(const char *str, const char *end)
+{
+    const char *eol = memchr(str, '\n', (size_t)(end - str));
+    if (eol == NULL)
+    {
+        eol = end;
+    }
+
+    const char *carriage_return = memchr(str, '\r', (size_t)(eol - str));
+    return carriage_return != NULL ? carriage_return : eol;
+}
+
+/* Terminates a value ending with its line, trimming trailing whitespace */
+static size_t kv_parse_value_end(char *value, size_t i)
+{
+    value[i] = '\0';
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (i > 0 && KV_PARSE_IS(value[i - 1], KV_PARSE_CLASS_SPACE))
+    {
+        i--;
+        value[i] = '\0';
+    }
+#endif
+    return i;
+}
+
+static int kv_parse_hex_digit(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+    {
+        return ch - '0';
+    }
+    else if (ch >= 'a' && ch <= 'f')
+    {
+        return ch - 'a' + 10;
+    }
+    else if (ch >= 'A' && ch <= 'F')
+    {
+        return ch - 'A' + 10;
+    }
+    return -1;
+}
+
+/* Decodes the escape sequence following a backslash into ch. Returns its length, or 0 if the backslash is literal */
+static size_t kv_parse_escape(const char *str, const char *end, char *ch)
+{
+    if (str == end)
+    {
+        return 0;
+    }
+
+    switch (*str)
+    {
+        case '\\':
+        case '"':
+        case '\'':
+            *ch = *str;
+            return 1;
+        case 'n':
+            *ch = '\n';
+            return 1;
+        case 't':
+            *ch = '\t';
+            return 1;
+        case 'r':
+            *ch = '\r';
+            return 1;
+        case '0':
+            *ch = '\0';
+            return 1;
+        case 'x':
+            if (end - str >= 3 && kv_parse_hex_digit(str[1]) >= 0 && kv_parse_hex_digit(str[2]) >= 0)
+            {
+                *ch = (char)(kv_parse_hex_digit(str[1]) * 16 + kv_parse_hex_digit(str[2]));
+                return 3;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Copies a quoted string body up to its closing quote, decoding escapes. Runs between backslashes are
+ * copied in bulk so long values copy at memcpy speed.
+ *
+ * Appends to value[*len] and updates *len. Returns the closing quote, end if the string is unterminated,
+ * or NULL if the value does not fit in value_max.
+ */
+static const char *kv_parse_quoted_copy(const char *str, const char *end, int quote, char *value, size_t *len, size_t value_max)
+{
+    size_t i = *len;
+    const char *close = memchr(str, quote, (size_t)(end - str));
+    if (close == NULL)
+    {
+        close = end;
+    }
+
+    for (;;)
+    {
+        /* Copy up to the next backslash or the closing quote */
+        const char *escape = memchr(str, '\\', (size_t)(close - str));
+        const char *run_end = (escape != NULL) ? escape : close;
+        size_t run = (size_t)(run_end - str);
+        if (run >= value_max - i)
+        {
+            return NULL;
+        }
+
+        /* Source and destination overlap when unescaping in place */
+        memmove(value + i, str, run);
+        i += run;
+        if (escape == NULL)
+        {
+            *len = i;
+            return close;
+        }
+
+        /* Escape Sequence. Unknown escapes keep the backslash */
+        char ch = '\\';
+        str = escape + 1 + kv_parse_escape(escape + 1, end, &ch);
+        if (i + 1 >= value_max)
+        {
+            return NULL;
+        }
+        value[i++] = ch;
+
+        if (str > close)
+        {
+            /* Closing quote was escaped. Find the next one */
+            close = memchr(str, quote, (size_t)(end - str));
+            if (close == NULL)
+            {
+                close = end;
+            }
+        }
+    }
+}
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+/* First quote in [str, end), or end */
+static const char *kv_parse_find_quote(const char *str, const char *end)
+{
+    const char *quote = memchr(str, '"', (size_t)(end - str));
+    if (quote == NULL)
+    {
+        quote = end;
+    }
+
+    const char *single = memchr(str, '\'', (size_t)(quote - str));
+    return (single != NULL) ? single : quote;
+}
+
+/* Closing quote of a quoted string body, or end if unterminated. Sets escaped if the body holds a backslash */
+static const char *kv_parse_quoted_close(const char *str, const char *end, int quote, bool *escaped)
+{
+    const char *close = memchr(str, quote, (size_t)(end - str));
+    if (close == NULL)
+    {
+        close = end;
+    }
+
+    for (;;)
+    {
+        const char *escape = memchr(str, '\\', (size_t)(close - str));
+        if (escape == NULL)
+        {
+            return close;
+        }
+
+        /* Escape Sequence. Its first byte can never close the string */
+        *escaped = true;
+        if (escape + 1 >= end)
+        {
+            return end;
+        }
+
+        str = escape + 2;
+        if (str > close)
+        {
+            /* Closing quote was escaped. Find the next one */
+            close = memchr(str, quote, (size_t)(end - str));
+            if (close == NULL)
+            {
+                close = end;
+            }
+        }
+    }
+}
+#endif
 
 char *kv_parse_buffer_next_line(char *str, size_t line_count)
 {
@@ -23,30 +386,22 @@ char *kv_parse_buffer_next_line(char *str, size_t line_count)
     }
 
     /* Advance to next line */
-    ch = *str;
-    str++;
-    while (ch != '\0')
+    str = kv_parse_buffer_scan_line(str);
+    if (*str == '\0')
     {
-        if (ch == '\n')
-        {
-            ch = *str;
-            return (ch == '\0') ? NULL : str;
-        }
-        ch = *str;
-        str++;
+        /* File Finished Reading */
+        return NULL;
     }
 
-    /* File Finished Reading */
-    return NULL;
+    str++;
+    ch = *str;
+    return (ch == '\0') ? NULL : str;
 }
 
 char *kv_parse_buffer_check_key(char *str, const char *key)
 {
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-    while (*str == ' ' || *str == '\t')
-    {
-        str++;
-    }
+    str = kv_parse_buffer_skip_whitespace(str);
 #endif
 
     /* Check For Key */
@@ -60,14 +415,67 @@ char *kv_parse_buffer_check_key(char *str, const char *key)
     }
 
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-    while (*str == ' ' || *str == '\t')
+    str = kv_parse_buffer_skip_whitespace(str);
+#endif
+
+    /* Check For Key Value Delimiter */
+    if (!KV_PARSE_IS(*str, KV_PARSE_CLASS_DELIMITER))
     {
-        str++;
+        return NULL;
+    }
+
+    /* Key Found. Next position is likely the value */
+    str++;
+    return str;
+}
+
+KV_PARSE_KEY_KERNEL static bool kv_parse_key_equal(const char *str, const kv_key *key)
+{
+    size_t i = 0;
+#ifdef KV_PARSE_KEY_WORDS
+    /* Bytes before str[i] matched the key so str[i] is at most the terminator. A load from it that stays in its page is mapped */
+    for (; i + 8 <= key->len && ((uintptr_t)(str + i) & (KV_PARSE_KEY_PAGE - 1)) <= KV_PARSE_KEY_PAGE - 8; i += 8)
+    {
+        uint64_t a;
+        uint64_t b;
+        memcpy(&a, str + i, 8);
+        memcpy(&b, key->str + i, 8);
+        if (a != b)
+        {
+            return false;
+        }
     }
 #endif
 
+    for (; i < key->len; i++)
+    {
+        if (str[i] != key->str[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+char *kv_parse_buffer_match_key(char *str, const kv_key *key)
+{
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    str = kv_parse_buffer_skip_whitespace(str);
+#endif
+
+    /* Check For Key */
+    if (!kv_parse_key_equal(str, key))
+    {
+        return NULL;
+    }
+    str += key->len;
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    str = kv_parse_buffer_skip_whitespace(str);
+#endif
+
     /* Check For Key Value Delimiter */
-    if (*str != '=' && *str != ':')
+    if (!KV_PARSE_IS(*str, KV_PARSE_CLASS_DELIMITER))
     {
         return NULL;
     }
@@ -80,56 +488,474 @@ char *kv_parse_buffer_check_key(char *str, const char *key)
 size_t kv_parse_buffer_get_value(char *str, char *value, size_t value_max)
 {
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-    while (*str == ' ' || *str == '\t')
-    {
-        str++;
-    }
+    str = kv_parse_buffer_skip_whitespace(str);
 #endif
 
     /* Copy Value To Buffer */
-#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
-    int quote = '\0';
-    int prev = '\0';
-#endif
     for (int i = 0; i < (value_max - 1); str++)
     {
-        if (*str == '\0' || *str == '\r' || *str == '\n')
+        if (KV_PARSE_IS(*str, KV_PARSE_CLASS_NUL | KV_PARSE_CLASS_EOL))
         {
             /* End Of Line */
-            value[i] = '\0';
-#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-            while (i > 0 && (value[i - 1] == ' ' || value[i - 1] == '\t'))
+            return kv_parse_value_end(value, i);
+        }
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        else if (KV_PARSE_IS(*str, KV_PARSE_CLASS_QUOTE))
+        {
+            /* Start Of Quoted String. Copy through to the closing quote */
+            const char *end = kv_parse_line_end(str + 1, kv_parse_buffer_scan_line(str + 1));
+            size_t len = i;
+            const char *close = kv_parse_quoted_copy(str + 1, end, *str, value, &len, value_max);
+            if (close == NULL)
             {
-                i--;
-                value[i] = '\0';
+                break;
+            }
+            else if (close == end)
+            {
+                /* Unterminated Quoted String. Value ends with the line */
+                return kv_parse_value_end(value, len);
             }
+
+            /* End Of Quoted String. Return Value */
+            value[len] = '\0';
+            return len;
+        }
 #endif
+
+        value[i++] = *str;
+    }
+
+    /* Value too large for buffer. Don't return a value. */
+    value[0] = '\0';
+    return 0;
+}
+
+kv_parse_view kv_parse_buffer_get_value_view(const char *str)
+{
+    /* Value ends with the line */
+    return kv_parse_span_get_value_view(str, kv_parse_buffer_scan_line((char *)str));
+}
+
+size_t kv_parse_view_unescape(kv_parse_view view, char *value, size_t value_max)
+{
+    if ((view.flags & KV_PARSE_VIEW_ESCAPED) == 0)
+    {
+        /* Plain value. Copy as is */
+        if (view.len > value_max - 1)
+        {
+            value[0] = '\0';
+            return 0;
+        }
+
+        memcpy(value, view.ptr, view.len);
+        value[view.len] = '\0';
+        return view.len;
+    }
+
+    if ((view.flags & KV_PARSE_VIEW_QUOTED) == 0)
+    {
+        /* Quoted string opened mid value. View spans the raw value */
+        return kv_parse_span_get_value(view.ptr, view.ptr + view.len, value, value_max);
+    }
+
+    /* Quoted string with escapes. Opening quote sits just before the view */
+    size_t len = 0;
+    if (kv_parse_quoted_copy(view.ptr, view.ptr + view.len, view.ptr[-1], value, &len, value_max) == NULL)
+    {
+        /* Value too large for buffer. Don't return a value. */
+        value[0] = '\0';
+        return 0;
+    }
+
+    value[len] = '\0';
+    return len;
+}
+
+size_t kv_parse_buffer_check_section(char *str, char *section, size_t section_max)
+{
+    /* Check For INI/TOML Section Opening Delimiter */
+    if (*str != '[')
+    {
+        return false;
+    }
+    str++;
+
+    /* Copy Section To Buffer */
+    for (int i = 0; i < (section_max - 1); str++)
+    {
+        /* Check For INI/TOML Section Closing Delimiter */
+        if (KV_PARSE_IS(*str, KV_PARSE_CLASS_NUL | KV_PARSE_CLASS_EOL))
+        {
+            /* End Of Line (Scan for closing bracket)*/
+            section[i] = '\0';
+            while (i > 0 && KV_PARSE_IS(section[i - 1], KV_PARSE_CLASS_SPACE))
+            {
+                i--;
+                section[i] = '\0';
+            }
+
+            /* Expecting closing bracket. Don't return a section if missing */
+            if (section[i - 1] != ']')
+            {
+                section[0] = '\0';
+                return 0;
+            }
+
+            /* Exclude closing bracket. Return section string. */
+            i--;
+            section[i] = '\0';
             return i;
         }
-#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
-        else if (quote == '\0' && (*str == '\'' || *str == '"'))
+
+        section[i++] = *str;
+    }
+
+    /* Value too large for buffer. Don't return a value. */
+    section[0] = '\0';
+    return 0;
+}
+
+size_t kv_parse_buffer_get_many(char *str, kv_parse_buffer_query *queries, size_t query_count)
+{
+    /* Build first byte and key hash filters over all queries */
+    uint32_t first_bytes[8] = {0};
+    uint32_t key_hashes[KV_PARSE_GET_MANY_FILTER_BITS / 32] = {0};
+    for (size_t q = 0; q < query_count; q++)
+    {
+        unsigned char first = (unsigned char)queries[q].key[0];
+        uint32_t hash = kv_parse_key_hash(queries[q].key, strlen(queries[q].key)) % KV_PARSE_GET_MANY_FILTER_BITS;
+        first_bytes[first >> 5] |= (uint32_t)1 << (first & 31);
+        key_hashes[hash >> 5] |= (uint32_t)1 << (hash & 31);
+        queries[q].found = false;
+        queries[q].value_len = 0;
+    }
+
+    size_t found = 0;
+    for (size_t line = 0; found < query_count && (str = kv_parse_buffer_next_line(str, line)) != NULL; line++)
+    {
+        char *key = str;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        key = kv_parse_buffer_skip_whitespace(key);
+#endif
+
+        /* Reject line if no query starts with this byte */
+        unsigned char first = (unsigned char)*key;
+        if ((first_bytes[first >> 5] & ((uint32_t)1 << (first & 31))) == 0)
         {
-            /* Start Of Quoted String */
-            quote = *str;
             continue;
         }
-        else if (quote != '\0' && prev != '\\' && *str == quote)
+
+        /* Scan For Key Value Delimiter */
+        char *delimiter = kv_parse_buffer_scan_delimiter(key);
+
+        if (!KV_PARSE_IS(*delimiter, KV_PARSE_CLASS_DELIMITER))
         {
-            /* End Of Quoted String. Return Value */
-            value[i] = '\0';
-            return i;
+            continue;
+        }
+
+        char *key_end = delimiter;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (key_end > key && KV_PARSE_IS(key_end[-1], KV_PARSE_CLASS_SPACE))
+        {
+            key_end--;
+        }
+#endif
+
+        /* Reject line if no query has this key hash */
+        size_t key_len = (size_t)(key_end - key);
+        uint32_t hash = kv_parse_key_hash(key, key_len) % KV_PARSE_GET_MANY_FILTER_BITS;
+        if ((key_hashes[hash >> 5] & ((uint32_t)1 << (hash & 31))) == 0)
+        {
+            continue;
+        }
+
+        /* Check For Key */
+        for (size_t q = 0; q < query_count; q++)
+        {
+            if (queries[q].found || strncmp(queries[q].key, key, key_len) != 0 || queries[q].key[key_len] != '\0')
+            {
+                continue;
+            }
+
+            /* Key Found. Extract value and keep scanning for any other query with the same key */
+            queries[q].value_len = kv_parse_buffer_get_value(delimiter + 1, queries[q].value, queries[q].value_max);
+            queries[q].found = true;
+            found++;
+        }
+    }
+
+    return found;
+}
+
+void kv_parse_buffer_iter_init(kv_parse_buffer_iter *it, const char *str)
+{
+    it->str = str;
+    it->line = 0;
+    it->section = "";
+    it->section_len = 0;
+    it->section_id = 0;
+}
+
+bool kv_parse_buffer_iter_next(kv_parse_buffer_iter *it, kv_parse_record *rec)
+{
+    while (*it->str != '\0')
+    {
+        /* Find End Of Line. Next line starts after the newline */
+        const char *str = it->str;
+        const char *eol = kv_parse_buffer_scan_line((char *)str);
+        const char *end = memchr(str, '\r', (size_t)(eol - str));
+        if (end == NULL)
+        {
+            end = eol;
         }
-        else if (quote != '\0' && prev == '\\' && *str == quote)
+        size_t line = it->line++;
+        it->str = (*eol == '\n') ? eol + 1 : eol;
+
+        /* Check For INI/TOML Section Header */
+        if (*str == '[')
         {
-            /* Escaped Character In Quoted String */
-            value[i - 1] = *str == '\0' ? '\0' : *str;
+            const char *last = end;
+            while (last > str + 1 && KV_PARSE_IS(last[-1], KV_PARSE_CLASS_SPACE))
+            {
+                last--;
+            }
+
+            /* "[]" has no name and is not a header, as in `kv_parse_buffer_check_section()` */
+            if (last > str + 2 && last[-1] == ']')
+            {
+                /* Exclude brackets */
+                it->section = str + 1;
+                it->section_len = (size_t)(last - 1 - it->section);
+                it->section_id++;
+                continue;
+            }
+        }
+
+        const char *key = str;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        key = kv_parse_buffer_skip_whitespace((char *)key);
+#endif
+
+        /* Scan For Key Value Delimiter */
+        const char *delimiter = kv_parse_buffer_scan_delimiter((char *)key);
+        if (delimiter >= end || !KV_PARSE_IS(*delimiter, KV_PARSE_CLASS_DELIMITER))
+        {
+            /* Not a key value line */
             continue;
         }
 
-        prev = *str;
+        const char *key_end = delimiter;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (key_end > key && KV_PARSE_IS(key_end[-1], KV_PARSE_CLASS_SPACE))
+        {
+            key_end--;
+        }
 #endif
 
-        value[i++] = *str == '\0' ? '\0' : *str;
+        rec->section = it->section;
+        rec->section_len = it->section_len;
+        rec->section_id = it->section_id;
+        rec->key = key;
+        rec->key_len = (size_t)(key_end - key);
+        rec->value = kv_parse_span_get_value_view(delimiter + 1, end);
+        rec->line = line;
+        return true;
+    }
+
+    /* End Of Buffer */
+    return false;
+}
+
+char *kv_parse_buffer_inplace_next(kv_parse_buffer_iter *it, char **value)
+{
+    kv_parse_record rec;
+    if (!kv_parse_buffer_iter_next(it, &rec))
+    {
+        /* End Of Buffer */
+        return NULL;
+    }
+
+    /* Iterator already moved past this line, so it can be overwritten */
+    char *key = (char *)rec.key;
+    char *str = (char *)rec.value.ptr;
+    key[rec.key_len] = '\0';
+    if (it->section_id > 0)
+    {
+        /* Replace closing bracket. Section name before the first header is a literal "" */
+        ((char *)it->section)[it->section_len] = '\0';
+    }
+
+    if (rec.value.flags & KV_PARSE_VIEW_ESCAPED)
+    {
+        /* Decoded value is never longer than the escaped one */
+        kv_parse_view_unescape(rec.value, str, rec.value.len + 1);
+    }
+    else
+    {
+        str[rec.value.len] = '\0';
+    }
+
+    *value = str;
+    return key;
+}
+
+const char *kv_parse_span_next_line(const char *str, const char *end, size_t line_count)
+{
+    /* Check if first line */
+    if (line_count == 0)
+    {
+        /* Already at next line */
+        return str;
+    }
+
+    /* Advance to next line */
+    const char *newline = memchr(str, '\n', (size_t)(end - str));
+    if (newline == NULL || newline + 1 == end)
+    {
+        /* File Finished Reading */
+        return NULL;
+    }
+
+    return newline + 1;
+}
+
+const char *kv_parse_span_check_key(const char *str, const char *end, const char *key)
+{
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (str < end && KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        str++;
+    }
+#endif
+
+    /* Check For Key */
+    for (int i = 0; key[i] != '\0'; i++, str++)
+    {
+        if (str == end || *str != key[i])
+        {
+            /* End of buffer. Key was not found */
+            return NULL;
+        }
+    }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (str < end && KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        str++;
+    }
+#endif
+
+    /* Check For Key Value Delimiter */
+    if (str == end || !KV_PARSE_IS(*str, KV_PARSE_CLASS_DELIMITER))
+    {
+        return NULL;
+    }
+
+    /* Key Found. Next position is likely the value */
+    str++;
+    return str;
+}
+
+const char *kv_parse_span_match_key(const char *str, const char *end, const kv_key *key)
+{
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (str < end && KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        str++;
+    }
+#endif
+
+    /* Line must hold the key and a delimiter */
+    if ((size_t)(end - str) <= key->len)
+    {
+        return NULL;
+    }
+
+    /* Check the byte after the key first. Most other keys are rejected here */
+    const char *after = str + key->len;
+    if (!KV_PARSE_IS(*after, KV_PARSE_CLASS_DELIMITER | KV_PARSE_CLASS_SPACE))
+    {
+        return NULL;
+    }
+
+    /* Check For Key */
+    size_t i = 0;
+    for (; i + 8 <= key->len; i += 8)
+    {
+        uint64_t a;
+        uint64_t b;
+        memcpy(&a, str + i, 8);
+        memcpy(&b, key->str + i, 8);
+        if (a != b)
+        {
+            return NULL;
+        }
+    }
+    if (memcmp(str + i, key->str + i, key->len - i) != 0)
+    {
+        return NULL;
+    }
+    str = after;
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (str < end && KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        str++;
+    }
+#endif
+
+    /* Check For Key Value Delimiter */
+    if (str == end || !KV_PARSE_IS(*str, KV_PARSE_CLASS_DELIMITER))
+    {
+        return NULL;
+    }
+
+    /* Key Found. Next position is likely the value */
+    str++;
+    return str;
+}
+
+size_t kv_parse_span_get_value(const char *str, const char *end, char *value, size_t value_max)
+{
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (str < end && KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        str++;
+    }
+#endif
+
+    /* Copy Value To Buffer */
+    for (size_t i = 0; i + 1 < value_max; str++)
+    {
+        if (str == end || KV_PARSE_IS(*str, KV_PARSE_CLASS_EOL))
+        {
+            /* End Of Line */
+            return kv_parse_value_end(value, i);
+        }
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        else if (KV_PARSE_IS(*str, KV_PARSE_CLASS_QUOTE))
+        {
+            /* Start Of Quoted String. Copy through to the closing quote */
+            const char *eol = kv_parse_line_end(str + 1, end);
+            size_t len = i;
+            const char *close = kv_parse_quoted_copy(str + 1, eol, *str, value, &len, value_max);
+            if (close == NULL)
+            {
+                break;
+            }
+            else if (close == eol)
+            {
+                /* Unterminated Quoted String. Value ends with the line */
+                return kv_parse_value_end(value, len);
+            }
+
+            /* End Of Quoted String. Return Value */
+            value[len] = '\0';
+            return len;
+        }
+#endif
+
+        value[i++] = *str;
     }
 
     /* Value too large for buffer. Don't return a value. */
@@ -137,31 +963,88 @@ size_t kv_parse_buffer_get_value(char *str, char *value, size_t value_max)
     return 0;
 }
 
-size_t kv_parse_buffer_check_section(char *str, char *section, size_t section_max)
+kv_parse_view kv_parse_span_get_value_view(const char *str, const char *end)
+{
+    kv_parse_view view = {NULL, 0, 0};
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (str < end && KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        str++;
+    }
+#endif
+
+    /* Value ends with the line */
+    end = kv_parse_line_end(str, end);
+    const char *start = str;
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    const char *quote = kv_parse_find_quote(str, end);
+    if (quote < end)
+    {
+        bool escaped = false;
+        const char *close = kv_parse_quoted_close(quote + 1, end, *quote, &escaped);
+        if (quote == start)
+        {
+            /* Start Of Quoted String. Exclude quotes from view */
+            view.flags |= KV_PARSE_VIEW_QUOTED | (escaped ? KV_PARSE_VIEW_ESCAPED : 0);
+            start++;
+        }
+        else
+        {
+            /* Quoted string opening mid value. View spans the raw value including quotes */
+            view.flags |= KV_PARSE_VIEW_ESCAPED;
+        }
+
+        if (close < end)
+        {
+            /* End Of Quoted String */
+            view.ptr = start;
+            view.len = (size_t)(close - start) + ((view.flags & KV_PARSE_VIEW_QUOTED) ? 0 : 1);
+            return view;
+        }
+    }
+#endif
+
+    /* End Of Line */
+    str = end;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (str > start && KV_PARSE_IS(str[-1], KV_PARSE_CLASS_SPACE))
+    {
+        str--;
+    }
+#endif
+
+    view.ptr = start;
+    view.len = (size_t)(str - start);
+    return view;
+}
+
+size_t kv_parse_span_check_section(const char *str, const char *end, char *section, size_t section_max)
 {
     /* Check For INI/TOML Section Opening Delimiter */
-    if (*str != '[')
+    if (str == end || *str != '[')
     {
-        return false;
+        return 0;
     }
     str++;
 
     /* Copy Section To Buffer */
-    for (int i = 0; i < (section_max - 1); str++)
+    for (size_t i = 0; i + 1 < section_max; str++)
     {
         /* Check For INI/TOML Section Closing Delimiter */
-        if (*str == '\0' || *str == '\r' || *str == '\n')
+        if (str == end || KV_PARSE_IS(*str, KV_PARSE_CLASS_EOL))
         {
             /* End Of Line (Scan for closing bracket)*/
             section[i] = '\0';
-            while (i > 0 && (section[i - 1] == ' ' || section[i - 1] == '\t'))
+            while (i > 0 && KV_PARSE_IS(section[i - 1], KV_PARSE_CLASS_SPACE))
             {
                 i--;
                 section[i] = '\0';
             }
 
             /* Expecting closing bracket. Don't return a section if missing */
-            if (section[i - 1] != ']')
+            if (i == 0 || section[i - 1] != ']')
             {
                 section[0] = '\0';
                 return 0;
@@ -24,9 +24,107 @@
 #ifndef KV_PARSE_BUFFER_H
 #define KV_PARSE_BUFFER_H
 
+#include "kv_parse_key.h"
 #include <stdbool.h>
 #include <stddef.h>
 
+/* Bits in the key hash filter used by `kv_parse_buffer_get_many()` to reject lines */
+#ifndef KV_PARSE_GET_MANY_FILTER_BITS
+#define KV_PARSE_GET_MANY_FILTER_BITS 2048
+#endif
+
+/* View flag: value was enclosed in quotes, which are not part of the view */
+#define KV_PARSE_VIEW_QUOTED 0x01
+
+/* View flag: view contains escapes or quotes and must be decoded with `kv_parse_view_unescape()` */
+#define KV_PARSE_VIEW_ESCAPED 0x02
+
+/**
+ * @brief Value located in place inside the input buffer.
+ *
+ * The view is not null terminated. Unless KV_PARSE_VIEW_ESCAPED is set, the bytes
+ * `ptr[0..len)` are exactly the value that `kv_parse_buffer_get_value()` would copy out.
+ */
+typedef struct kv_parse_view
+{
+    const char *ptr;
+    size_t len;
+    unsigned flags;
+} kv_parse_view;
+
+/**
+ * @brief One key lookup in a `kv_parse_buffer_get_many()` batch.
+ */
+typedef struct kv_parse_buffer_query
+{
+    const char *key;  /* Key to search for */
+    char *value;      /* Buffer to store the extracted value */
+    size_t value_max; /* Maximum size of the value buffer */
+    size_t value_len; /* Output: Length of the extracted value */
+    bool found;       /* Output: true if the key was found */
+} kv_parse_buffer_query;
+
+/**
+ * @brief One key value line returned by `kv_parse_buffer_iter_next()`.
+ *
+ * All spans point into the iterated buffer and are not null terminated.
+ */
+typedef struct kv_parse_record
+{
+    const char *section; /* Name of the enclosing `[section]`, "" before the first header */
+    size_t section_len;
+    size_t section_id; /* 0 before the first header, incremented on every header */
+    const char *key;
+    size_t key_len;
+    kv_parse_view value; /* Value with whitespace and quotes trimmed. See `kv_parse_view_unescape()` */
+    size_t line;         /* Line number (0-based) */
+} kv_parse_record;
+
+/**
+ * @brief Record iterator state. Initialise with `kv_parse_buffer_iter_init()`.
+ */
+typedef struct kv_parse_buffer_iter
+{
+    const char *str;
+    size_t line;
+    const char *section;
+    size_t section_len;
+    size_t section_id;
+} kv_parse_buffer_iter;
+
+/**
+ * @brief Finds the end of the current line.
+ *
+ * @param str Pointer to the current position in the string buffer.
+ *
+ * @return Pointer to the first '\n' or the terminating '\0'.
+ *
+ * @note Unless KV_PARSE_DISABLE_SIMD is defined, this uses SSE2 or AVX2 kernels picked at runtime on x86.
+ *       Define KV_PARSE_SCAN_FORCE_PORTABLE, KV_PARSE_SCAN_FORCE_SSE2 or KV_PARSE_SCAN_FORCE_AVX2 to pin a kernel.
+ */
+char *kv_parse_buffer_scan_line(char *str);
+
+/**
+ * @brief Finds the key value delimiter on the current line.
+ *
+ * @param str Pointer to the current position in the string buffer.
+ *
+ * @return Pointer to the first '=', ':', registered delimiter, '\n' or the terminating '\0'.
+ *
+ * @note Uses the same vector kernels as `kv_parse_buffer_scan_line()`. Each delimiter registered with
+ *       `kv_parse_class_add_delimiter()` adds one compare per vector.
+ */
+char *kv_parse_buffer_scan_delimiter(char *str);
+
+/**
+ * @brief Skips spaces and tabs.
+ *
+ * @param str Pointer to the current position in the string buffer.
+ *
+ * @return Pointer to the first character that is not a space or tab.
+ */
+char *kv_parse_buffer_skip_whitespace(char *str);
+
 /**
  * @brief Advances the string pointer to the next line in the buffer.
  *
@@ -55,12 +153,31 @@ char *kv_parse_buffer_next_line(char *str, size_t line_count);
  */
 char *kv_parse_buffer_check_key(char *str, const char *key);
 
+/**
+ * @brief Checks if the given line contains the key described by a key descriptor.
+ *
+ * Same as `kv_parse_buffer_check_key()` but the key length is known up front, so the key is
+ * compared without scanning for its end.
+ *
+ * @param str Pointer to the current position in the buffer (beginning of a line).
+ * @param key Key descriptor built with `KV_PARSE_KEY()` or `kv_parse_key()`.
+ *
+ * @return Pointer to the position after the key value delimiter if found, NULL otherwise.
+ *
+ * @note If KV_PARSE_ENABLE_KEY_OVERREAD is defined (and KV_PARSE_DISABLE_SIMD is not), the key is compared
+ *       8 bytes at a time. Words are loaded without crossing a page boundary, which may read past the
+ *       end of the string within the same page and is reported by tools such as valgrind.
+ */
+char *kv_parse_buffer_match_key(char *str, const kv_key *key);
+
 /**
  * @brief Extracts the value associated with a key from a string.
  *
  * This function copies the value from the given string into the provided buffer.
  * It stops at the end of the line or when the buffer reaches its maximum size.
  * Optionally, it can handle quoted strings if KV_PARSE_QUOTED_STRINGS is defined.
+ * Escapes inside quotes are decoded: \\ \" \' \n \t \r \0 and \xHH. Other backslashes are kept as is.
+ * Quoted strings are copied in bulk between backslashes.
  *
  * @param str Pointer to the start of the value in the key-value pair.
  * @param value Buffer to store the extracted value.
@@ -70,6 +187,29 @@ char *kv_parse_buffer_check_key(char *str, const char *key);
  */
 size_t kv_parse_buffer_get_value(char *str, char *value, size_t value_max);
 
+/**
+ * @brief Locates the value associated with a key without copying it.
+ *
+ * Leading whitespace, quotes and trailing whitespace are removed by adjusting the returned span
+ * rather than copying. Escapes are left in place and flagged with KV_PARSE_VIEW_ESCAPED.
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ *
+ * @return View of the value inside `str`.
+ */
+kv_parse_view kv_parse_buffer_get_value_view(const char *str);
+
+/**
+ * @brief Copies a value view into a buffer, decoding escapes if flagged.
+ *
+ * @param view View returned by `kv_parse_buffer_get_value_view()` or `kv_parse_span_get_value_view()`.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the value is too large or empty.
+ */
+size_t kv_parse_view_unescape(kv_parse_view view, char *value, size_t value_max);
+
 /**
  * @brief Parses and extracts an INI/TOML-style section header.
  *
@@ -84,4 +224,142 @@ size_t kv_parse_buffer_get_value(char *str, char *value, size_t value_max);
  * @note If the section name exceeds `section_max - 1`, the function resets the file position and returns 0.
  */
 size_t kv_parse_buffer_check_section(char *str, char *section, size_t section_max);
+
+/**
+ * @brief Extracts the values of many keys in a single pass over the buffer.
+ *
+ * Each line is matched against every query at once. Lines are first filtered by the first
+ * byte and a hash of their key so most lines are rejected without comparing any key.
+ * Scanning stops as soon as every query is found. Duplicate keys return the first occurrence.
+ *
+ * @param str Pointer to the string buffer containing the key-value pairs.
+ * @param queries Array of queries. `found` and `value_len` are filled in for each query.
+ * @param query_count Number of queries.
+ *
+ * @return The number of queries found.
+ */
+size_t kv_parse_buffer_get_many(char *str, kv_parse_buffer_query *queries, size_t query_count);
+
+/**
+ * @brief Starts iterating over the key value records of a buffer.
+ *
+ * @param it Iterator to initialise.
+ * @param str Buffer to iterate. Must outlive the returned records.
+ */
+void kv_parse_buffer_iter_init(kv_parse_buffer_iter *it, const char *str);
+
+/**
+ * @brief Returns the next key value record of a buffer.
+ *
+ * Each line is classified once as a section header, a key value line or other, so reading a
+ * whole config is a single pass. Lines follow the same rules as `kv_parse_buffer_next_line()`,
+ * `kv_parse_buffer_check_key()`, `kv_parse_buffer_get_value_view()` and `kv_parse_buffer_check_section()`.
+ * Lines without a key value delimiter ('=' or ':') are skipped. A `[]` line has no name and is
+ * not a header, so it neither starts a section nor increments the section id.
+ *
+ * @param it Iterator initialised with `kv_parse_buffer_iter_init()`.
+ * @param rec Record to fill in.
+ *
+ * @return true if a record was returned, false at the end of the buffer.
+ */
+bool kv_parse_buffer_iter_next(kv_parse_buffer_iter *it, kv_parse_record *rec);
+
+/**
+ * @brief Returns the next key value record of a buffer, null terminating it inside the buffer.
+ *
+ * Works like `strtok()`: the key, the value and the current section name are terminated in place
+ * and quoted values are unescaped in place, so no value buffers are needed. Lines follow the same
+ * rules as `kv_parse_buffer_iter_next()`. The buffer is modified and can only be parsed once.
+ *
+ * @param it Iterator initialised with `kv_parse_buffer_iter_init()` on a writable buffer.
+ *           `it->section` is the null terminated section name of the returned key, "" before the first header.
+ * @param value Set to the null terminated value.
+ *
+ * @return The null terminated key, or NULL at the end of the buffer. Pointers stay valid as long as the buffer.
+ *
+ * @note A "\0" escape in a quoted value ends the value early when read as a C string.
+ */
+char *kv_parse_buffer_inplace_next(kv_parse_buffer_iter *it, char **value);
+
+/**
+ * @brief Advances to the next line in a length bounded, read only buffer.
+ *
+ * Same as `kv_parse_buffer_next_line()` but the buffer ends at `end` instead of at '\0',
+ * so mapped files and sub slices of larger buffers can be parsed in place.
+ *
+ * @param str Pointer to the current position in the buffer.
+ * @param end Pointer one past the last byte of the buffer.
+ * @param line_count The current line number (0-based). If line_count is 0, the function
+ *        returns the input pointer unchanged.
+ *
+ * @return Pointer to the start of the next line, or NULL if the end of the buffer is reached.
+ */
+const char *kv_parse_span_next_line(const char *str, const char *end, size_t line_count);
+
+/**
+ * @brief Checks if the given line of a length bounded buffer contains the specified key.
+ *
+ * Same as `kv_parse_buffer_check_key()` but the buffer ends at `end` instead of at '\0'.
+ *
+ * @param str Pointer to the start of the line.
+ * @param end Pointer one past the last byte of the buffer.
+ * @param key The key to search for in the buffer.
+ *
+ * @return Pointer to the value portion of the line if the key is found, otherwise NULL.
+ */
+const char *kv_parse_span_check_key(const char *str, const char *end, const char *key);
+
+/**
+ * @brief Checks if the given line of a length bounded buffer contains the key described by a key descriptor.
+ *
+ * Same as `kv_parse_span_check_key()` but lines too short to hold the key are rejected without
+ * reading them, and the key is compared 8 bytes at a time.
+ *
+ * @param str Pointer to the current position in the buffer (beginning of a line).
+ * @param end Pointer one past the last byte of the buffer.
+ * @param key Key descriptor built with `KV_PARSE_KEY()` or `kv_parse_key()`.
+ *
+ * @return Pointer to the position after the key value delimiter if found, NULL otherwise.
+ */
+const char *kv_parse_span_match_key(const char *str, const char *end, const kv_key *key);
+
+/**
+ * @brief Extracts the value associated with a key from a length bounded buffer.
+ *
+ * Same as `kv_parse_buffer_get_value()` but the buffer ends at `end` instead of at '\0'.
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ * @param end Pointer one past the last byte of the buffer.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the value is too large or empty.
+ */
+size_t kv_parse_span_get_value(const char *str, const char *end, char *value, size_t value_max);
+
+/**
+ * @brief Locates the value associated with a key in a length bounded buffer without copying it.
+ *
+ * Same as `kv_parse_buffer_get_value_view()` but the buffer ends at `end` instead of at '\0'.
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ * @param end Pointer one past the last byte of the buffer.
+ *
+ * @return View of the value inside the buffer.
+ */
+kv_parse_view kv_parse_span_get_value_view(const char *str, const char *end);
+
+/**
+ * @brief Parses and extracts an INI/TOML-style section header from a length bounded buffer.
+ *
+ * Same as `kv_parse_buffer_check_section()` but the buffer ends at `end` instead of at '\0'.
+ *
+ * @param str Pointer to the start of the line.
+ * @param end Pointer one past the last byte of the buffer.
+ * @param section Buffer to store the extracted section name.
+ * @param section_max Maximum size of the buffer (including null terminator).
+ *
+ * @return The length of the extracted section name on success, 0 on failure.
+ */
+size_t kv_parse_span_check_section(const char *str, const char *end, char *section, size_t section_max);
 #endif
@@ -0,0 +1,73 @@
+/**
+ * @file kv_parse_class.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains the byte classification table shared by the parsers. Each byte maps to a set
+ * of class bits (whitespace, key value delimiter, quote, line end), so a character test is one
+ * table load and mask instead of a chain of comparisons.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#include "kv_parse_class.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Default Classes. Indexed by byte + 1 */
+static const unsigned char kv_parse_class_default[257] = {
+    [0] = KV_PARSE_CLASS_EOF,
+    ['\0' + 1] = KV_PARSE_CLASS_NUL,
+    [' ' + 1] = KV_PARSE_CLASS_SPACE,
+    ['\t' + 1] = KV_PARSE_CLASS_SPACE,
+    ['=' + 1] = KV_PARSE_CLASS_DELIMITER,
+    [':' + 1] = KV_PARSE_CLASS_DELIMITER,
+    ['\'' + 1] = KV_PARSE_CLASS_QUOTE,
+    ['"' + 1] = KV_PARSE_CLASS_QUOTE,
+    ['\r' + 1] = KV_PARSE_CLASS_EOL,
+    ['\n' + 1] = KV_PARSE_CLASS_EOL | KV_PARSE_CLASS_LINE_FEED,
+};
+
+unsigned char kv_parse_class_table[257] = {
+    [0] = KV_PARSE_CLASS_EOF,
+    ['\0' + 1] = KV_PARSE_CLASS_NUL,
+    [' ' + 1] = KV_PARSE_CLASS_SPACE,
+    ['\t' + 1] = KV_PARSE_CLASS_SPACE,
+    ['=' + 1] = KV_PARSE_CLASS_DELIMITER,
+    [':' + 1] = KV_PARSE_CLASS_DELIMITER,
+    ['\'' + 1] = KV_PARSE_CLASS_QUOTE,
+    ['"' + 1] = KV_PARSE_CLASS_QUOTE,
+    ['\r' + 1] = KV_PARSE_CLASS_EOL,
+    ['\n' + 1] = KV_PARSE_CLASS_EOL | KV_PARSE_CLASS_LINE_FEED,
+};
+
+char kv_parse_class_delimiters[KV_PARSE_CLASS_EXTRA_MAX + 4] = "=:\n";
+size_t kv_parse_class_extra_delimiters = 0;
+
+bool kv_parse_class_add_delimiter(char ch)
+{
+    unsigned char *entry = &kv_parse_class_table[(unsigned char)ch + 1];
+
+    if (*entry == KV_PARSE_CLASS_DELIMITER)
+    {
+        /* Already a delimiter */
+        return true;
+    }
+
+    if (*entry != 0 || ch == '[' || kv_parse_class_extra_delimiters == KV_PARSE_CLASS_EXTRA_MAX)
+    {
+        /* Reserved character or the scan set is full */
+        return false;
+    }
+
+    *entry = KV_PARSE_CLASS_DELIMITER;
+    kv_parse_class_delimiters[3 + kv_parse_class_extra_delimiters++] = ch;
+    return true;
+}
+
+void kv_parse_class_reset(void)
+{
+    memcpy(kv_parse_class_table, kv_parse_class_default, sizeof(kv_parse_class_table));
+    memset(kv_parse_class_delimiters + 3, 0, KV_PARSE_CLASS_EXTRA_MAX);
+    kv_parse_class_extra_delimiters = 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file kv_parse_class.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains the byte classification table shared by the parsers. Each byte maps to a set
+ * of class bits (whitespace, key value delimiter, quote, line end), so a character test is one
+ * table load and mask instead of a chain of comparisons.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * kv_parse_class_add_delimiter(' ');  // Fails. Space is whitespace
+ * kv_parse_class_add_delimiter('~');  // Accept "key~value" lines
+ * @endcode
+ */
+#ifndef KV_PARSE_CLASS_H
+#define KV_PARSE_CLASS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Byte Classes */
+#define KV_PARSE_CLASS_SPACE 0x01     /* ' ' '\t' */
+#define KV_PARSE_CLASS_DELIMITER 0x02 /* '=' ':' and registered delimiters */
+#define KV_PARSE_CLASS_QUOTE 0x04     /* '\'' '"' */
+#define KV_PARSE_CLASS_EOL 0x08       /* '\r' '\n' */
+#define KV_PARSE_CLASS_LINE_FEED 0x10 /* '\n' */
+#define KV_PARSE_CLASS_NUL 0x20       /* '\0' */
+#define KV_PARSE_CLASS_EOF 0x40       /* EOF from getc() */
+
+/**
+ * @brief Class bits of every byte, offset by one so that EOF (-1) has an entry.
+ *
+ * Read through the macros below. Modify only with `kv_parse_class_add_delimiter()`.
+ */
+extern unsigned char kv_parse_class_table[257];
+
+/* Most delimiters `kv_parse_class_add_delimiter()` accepts. Each costs one more compare per vector in buffer scans */
+#ifndef KV_PARSE_CLASS_EXTRA_MAX
+#define KV_PARSE_CLASS_EXTRA_MAX 8
+#endif
+
+/* Delimiter scan set. "=:\n" followed by the registered delimiters, null terminated */
+extern char kv_parse_class_delimiters[KV_PARSE_CLASS_EXTRA_MAX + 4];
+
+/* Number of delimiters registered with `kv_parse_class_add_delimiter()` */
+extern size_t kv_parse_class_extra_delimiters;
+
+/* True if char c is in any of the classes */
+#define KV_PARSE_IS(c, classes) ((kv_parse_class_table[(unsigned char)(c) + 1] & (classes)) != 0)
+
+/* True if a getc() result (EOF or 0 to 255) is in any of the classes */
+#define KV_PARSE_IS_CH(ch, classes) ((kv_parse_class_table[(ch) + 1] & (classes)) != 0)
+
+/**
+ * @brief Registers an extra key value delimiter character.
+ *
+ * All parsers then accept it wherever '=' and ':' are accepted. Character tests cost the
+ * same however many delimiters are registered. Buffer scans for a delimiter compare each
+ * vector against the registered delimiters as well.
+ *
+ * @param ch Delimiter character. Must not already be whitespace, a quote, a line end, '\0' or '['.
+ *
+ * @return true if the delimiter was registered or already was one, false if the character is reserved
+ *         or KV_PARSE_CLASS_EXTRA_MAX delimiters are already registered.
+ *
+ * @warning The table is process wide and not synchronised. Register delimiters before any parsing
+ *          starts and before other threads (including parallel index builds) are created.
+ */
+bool kv_parse_class_add_delimiter(char ch);
+
+/**
+ * @brief Restores the default classes, removing registered delimiters.
+ *
+ * @warning Same as `kv_parse_class_add_delimiter()`. Never call while another thread parses.
+ */
+void kv_parse_class_reset(void);
+
+#endif
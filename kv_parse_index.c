@@ -0,0 +1,607 @@
+/**
+ * @file kv_parse_index.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a single pass indexer for the buffer parser. The buffer is tokenized once
+ * into a table of key and value spans so that repeated key lookups do not need to rescan the buffer.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#if !defined(_POSIX_C_SOURCE) && !defined(KV_PARSE_DISABLE_THREADS)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "kv_parse_index.h"
+#include "kv_parse_buffer.h"
+#include "kv_parse_class.h"
+#include "kv_parse_key.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(KV_PARSE_DISABLE_THREADS) && (defined(__unix__) || defined(__APPLE__))
+#define KV_PARSE_INDEX_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) && !defined(KV_PARSE_DISABLE_SIMD)
+#include <emmintrin.h>
+#endif
+
+/* Control byte marking an unused slot. Used slots hold the low 7 bits of the key hash */
+#define KV_PARSE_INDEX_EMPTY 0x80
+
+/* Entry position returned when a key is not in the index */
+#define KV_PARSE_INDEX_NONE SIZE_MAX
+
+/* Entry position returned when a bounded probe ran out of groups before finding the key or an empty slot */
+#define KV_PARSE_INDEX_FULL (SIZE_MAX - 1)
+
+/* Most threads used by the parallel indexer */
+#define KV_PARSE_INDEX_THREADS_MAX 64
+
+/* Least bytes handed to each thread by the parallel indexer */
+#ifndef KV_PARSE_INDEX_CHUNK_MIN
+#define KV_PARSE_INDEX_CHUNK_MIN (64 * 1024)
+#endif
+
+static uint32_t kv_parse_index_hash(const char *key, size_t key_len)
+{
+    /* Same hash as key descriptors so `kv_parse_index_get_key()` can use theirs */
+    return kv_parse_key_mix(kv_parse_key_hash(key, key_len));
+}
+
+static bool kv_parse_index_is_section(const char *str)
+{
+    /* Check For INI/TOML Section Opening Delimiter */
+    if (*str != '[')
+    {
+        return false;
+    }
+
+    /* Find last non whitespace character of the line */
+    const char *name = str + 1;
+    const char *last = NULL;
+    for (str++; !KV_PARSE_IS(*str, KV_PARSE_CLASS_NUL | KV_PARSE_CLASS_EOL); str++)
+    {
+        if (!KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+        {
+            last = str;
+        }
+    }
+
+    /* Expecting closing bracket. "[]" has no name and is not a header, as in `kv_parse_buffer_check_section()` */
+    return last != NULL && last > name && *last == ']';
+}
+
+#if defined(__SSE2__) && !defined(KV_PARSE_DISABLE_SIMD)
+static uint32_t kv_parse_index_match(const uint8_t *ctrl, uint8_t byte)
+{
+    /* Compare all 16 control bytes of the group at once */
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)byte)));
+}
+#else
+static uint32_t kv_parse_index_match(const uint8_t *ctrl, uint8_t byte)
+{
+    uint32_t mask = 0;
+    for (int i = 0; i < KV_PARSE_INDEX_GROUP; i++)
+    {
+        mask |= (uint32_t)(ctrl[i] == byte) << i;
+    }
+    return mask;
+}
+#endif
+
+static int kv_parse_index_first_bit(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int i = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+static size_t kv_parse_index_home(const kv_parse_index *index, uint32_t hash)
+{
+    return (hash >> 7) % index->groups;
+}
+
+/* Probes from the home group of the key, stopping short of group `group_end`. SIZE_MAX probes the whole table */
+static size_t kv_parse_index_probe_until(const kv_parse_index *index, const char *key, size_t key_len, uint32_t hash, size_t group_end, size_t *empty_slot)
+{
+    uint8_t h2 = (uint8_t)(hash & 0x7F);
+
+    for (size_t group = kv_parse_index_home(index, hash);; group %= index->groups)
+    {
+        size_t base = group * KV_PARSE_INDEX_GROUP;
+
+        /* Check slots whose control byte matches the hash */
+        for (uint32_t mask = kv_parse_index_match(index->ctrl + base, h2); mask != 0; mask &= mask - 1)
+        {
+            size_t entry = index->slot[base + kv_parse_index_first_bit(mask)];
+            if (index->hash[entry] == hash && index->key_len[entry] == key_len && memcmp(index->buffer + index->key_offset[entry], key, key_len) == 0)
+            {
+                return entry;
+            }
+        }
+
+        /* An empty slot ends the probe sequence. Key is not in the table */
+        uint32_t empty = kv_parse_index_match(index->ctrl + base, KV_PARSE_INDEX_EMPTY);
+        if (empty != 0)
+        {
+            if (empty_slot != NULL)
+            {
+                *empty_slot = base + kv_parse_index_first_bit(empty);
+            }
+            return KV_PARSE_INDEX_NONE;
+        }
+
+        /* A bounded probe does not wrap around */
+        if (++group == group_end)
+        {
+            return KV_PARSE_INDEX_FULL;
+        }
+    }
+}
+
+static size_t kv_parse_index_probe(const kv_parse_index *index, const char *key, size_t key_len, uint32_t hash, size_t *empty_slot)
+{
+    return kv_parse_index_probe_until(index, key, key_len, hash, SIZE_MAX, empty_slot);
+}
+
+static void kv_parse_index_insert(kv_parse_index *index, size_t entry)
+{
+    size_t empty_slot = 0;
+    if (kv_parse_index_probe(index, index->buffer + index->key_offset[entry], index->key_len[entry], index->hash[entry], &empty_slot) != KV_PARSE_INDEX_NONE)
+    {
+        /* Duplicate key. First occurrence wins */
+        return;
+    }
+
+    index->slot[empty_slot] = (uint32_t)entry;
+    index->ctrl[empty_slot] = (uint8_t)(index->hash[entry] & 0x7F);
+}
+
+void kv_parse_index_init(kv_parse_index *index, void *storage, size_t capacity)
+{
+    /* Align storage for the widest array */
+    unsigned char *ptr = (unsigned char *)storage;
+    ptr += (sizeof(size_t) - (uintptr_t)ptr % sizeof(size_t)) % sizeof(size_t);
+
+    index->buffer = NULL;
+    index->count = 0;
+    index->capacity = capacity;
+    index->threads = 0;
+    index->groups = KV_PARSE_INDEX_GROUPS(capacity);
+
+    /* Carve arrays in order of decreasing alignment */
+    size_t slots = index->groups * KV_PARSE_INDEX_GROUP;
+    index->key_offset = (size_t *)ptr;
+    ptr += capacity * sizeof(size_t);
+    index->value_offset = (size_t *)ptr;
+    ptr += capacity * sizeof(size_t);
+    index->key_len = (uint32_t *)ptr;
+    ptr += capacity * sizeof(uint32_t);
+    index->value_len = (uint32_t *)ptr;
+    ptr += capacity * sizeof(uint32_t);
+    index->hash = (uint32_t *)ptr;
+    ptr += capacity * sizeof(uint32_t);
+    index->section_id = (uint32_t *)ptr;
+    ptr += capacity * sizeof(uint32_t);
+    index->slot = (uint32_t *)ptr;
+    ptr += slots * sizeof(uint32_t);
+    index->ctrl = (uint8_t *)ptr;
+    memset(index->ctrl, KV_PARSE_INDEX_EMPTY, slots);
+}
+
+/* Section ids stop at UINT32_MAX rather than wrapping */
+static uint32_t kv_parse_index_section_add(uint32_t section_id, uint32_t sections)
+{
+    return (sections > UINT32_MAX - section_id) ? UINT32_MAX : section_id + sections;
+}
+
+static char *kv_parse_index_tokenize(kv_parse_index *index, char *str, const char *end, size_t first, size_t limit, size_t *count, uint32_t *section_id, bool store)
+{
+    /* Lines up to `end` (or '\0' if NULL) are stored from entry `first`. Returns where it stopped if `limit` was hit.
+       Without `store` entries and sections are only counted */
+    while (str != end && *str != '\0')
+    {
+        char *line = str;
+        char *eol = kv_parse_buffer_scan_line(line);
+        str = (*eol == '\n') ? eol + 1 : eol;
+
+        if (kv_parse_index_is_section(line))
+        {
+            *section_id = kv_parse_index_section_add(*section_id, 1);
+            continue;
+        }
+
+        char *key = line;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        key = kv_parse_buffer_skip_whitespace(key);
+#endif
+
+        /* Scan For Key Value Delimiter */
+        char *delimiter = kv_parse_buffer_scan_delimiter(key);
+
+        if (!KV_PARSE_IS(*delimiter, KV_PARSE_CLASS_DELIMITER))
+        {
+            /* Not a key value line */
+            continue;
+        }
+
+        if (!store)
+        {
+            (*count)++;
+            continue;
+        }
+
+        char *key_end = delimiter;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (key_end > key && KV_PARSE_IS(key_end[-1], KV_PARSE_CLASS_SPACE))
+        {
+            key_end--;
+        }
+#endif
+
+        /* Scan For End Of Value */
+        char *value = delimiter + 1;
+        char *value_end = eol;
+        char *carriage_return = memchr(value, '\r', (size_t)(value_end - value));
+        if (carriage_return != NULL)
+        {
+            value_end = carriage_return;
+        }
+
+        if (*count >= limit)
+        {
+            /* Index full */
+            return line;
+        }
+
+        size_t entry = first + (*count)++;
+        index->key_offset[entry] = (size_t)(key - index->buffer);
+        index->key_len[entry] = (uint32_t)(key_end - key);
+        index->value_offset[entry] = (size_t)(value - index->buffer);
+        index->value_len[entry] = (uint32_t)(value_end - value);
+        index->section_id[entry] = *section_id;
+        index->hash[entry] = kv_parse_index_hash(key, (size_t)(key_end - key));
+    }
+
+    return NULL;
+}
+
+bool kv_parse_buffer_index(kv_parse_index *index, char *str)
+{
+    index->buffer = str;
+    index->count = 0;
+    memset(index->ctrl, KV_PARSE_INDEX_EMPTY, index->groups * KV_PARSE_INDEX_GROUP);
+
+    index->threads = 1;
+
+    uint32_t section_id = 0;
+    bool complete = kv_parse_index_tokenize(index, str, NULL, 0, index->capacity, &index->count, &section_id, true) == NULL;
+
+    /* Insert in buffer order so the first occurrence of a key wins */
+    for (size_t entry = 0; entry < index->count; entry++)
+    {
+        kv_parse_index_insert(index, entry);
+    }
+
+    return complete;
+}
+
+#ifdef KV_PARSE_INDEX_THREADS
+typedef struct kv_parse_index_chunk
+{
+    kv_parse_index *index;
+
+    /* Tokenize: lines in [str, end) are stored from entry `first`, at most `limit` of them */
+    char *str;
+    const char *end;
+    size_t first;
+    size_t limit;
+    size_t count;      /* Entries in the chunk, including those past `limit` */
+    uint32_t sections; /* Section id at the start of the chunk, then at its end once run */
+    bool store;
+    bool overflow; /* More than `limit` entries. Those past it were only counted */
+
+    /* Insert: entries whose home group is in [group_first, group_end) */
+    size_t group_first;
+    size_t group_end;
+    size_t deferred; /* First entry whose probe ran past `group_end`, or KV_PARSE_INDEX_NONE */
+} kv_parse_index_chunk;
+
+static void *kv_parse_index_chunk_tokenize(void *arg)
+{
+    kv_parse_index_chunk *chunk = (kv_parse_index_chunk *)arg;
+    chunk->count = 0;
+    char *stop = kv_parse_index_tokenize(chunk->index, chunk->str, chunk->end, chunk->first, chunk->limit, &chunk->count, &chunk->sections, chunk->store);
+    chunk->overflow = stop != NULL;
+    if (stop != NULL)
+    {
+        /* Count the rest so the caller knows where every chunk belongs */
+        kv_parse_index_tokenize(chunk->index, stop, chunk->end, 0, 0, &chunk->count, &chunk->sections, false);
+    }
+    return NULL;
+}
+
+static void *kv_parse_index_chunk_insert(void *arg)
+{
+    /* Each thread owns a range of groups, so probes that stay inside it never race. An entry whose probe would
+       leave the range is deferred. Duplicates share a home group, so a key deferred once is deferred again */
+    kv_parse_index_chunk *chunk = (kv_parse_index_chunk *)arg;
+    kv_parse_index *index = chunk->index;
+    chunk->deferred = KV_PARSE_INDEX_NONE;
+
+    for (size_t entry = 0; entry < index->count; entry++)
+    {
+        size_t home = kv_parse_index_home(index, index->hash[entry]);
+        if (home < chunk->group_first || home >= chunk->group_end)
+        {
+            continue;
+        }
+
+        size_t empty_slot = 0;
+        size_t found = kv_parse_index_probe_until(index, index->buffer + index->key_offset[entry], index->key_len[entry], index->hash[entry], chunk->group_end, &empty_slot);
+        if (found == KV_PARSE_INDEX_NONE)
+        {
+            index->slot[empty_slot] = (uint32_t)entry;
+            index->ctrl[empty_slot] = (uint8_t)(index->hash[entry] & 0x7F);
+        }
+        else if (found == KV_PARSE_INDEX_FULL && chunk->deferred == KV_PARSE_INDEX_NONE)
+        {
+            chunk->deferred = entry;
+        }
+    }
+    return NULL;
+}
+
+/* Runs every chunk concurrently. The calling thread takes the first chunk */
+static void kv_parse_index_chunks_run(kv_parse_index_chunk *chunk, size_t chunks, void *(*run)(void *))
+{
+    pthread_t thread[KV_PARSE_INDEX_THREADS_MAX];
+    size_t started = 1;
+    for (; started < chunks; started++)
+    {
+        if (pthread_create(&thread[started], NULL, run, &chunk[started]) != 0)
+        {
+            break;
+        }
+    }
+    run(&chunk[0]);
+    for (size_t i = started; i < chunks; i++)
+    {
+        /* Thread could not be started. Run the chunk here */
+        run(&chunk[i]);
+    }
+    for (size_t i = 1; i < started; i++)
+    {
+        pthread_join(thread[i], NULL);
+    }
+}
+
+/* Moves each chunk from its window to its final entries, renumbering its sections to follow the chunks before it */
+static void kv_parse_index_chunks_compact(kv_parse_index *index, kv_parse_index_chunk *chunk, size_t chunks)
+{
+    size_t first = 0;
+    uint32_t section_id = 0;
+    for (size_t i = 0; i < chunks; i++)
+    {
+        size_t from = chunk[i].first;
+        size_t count = chunk[i].count;
+
+        /* Every earlier chunk fit its window, so `first` <= `from` and moving in chunk order never overwrites unmoved entries */
+        if (from != first)
+        {
+            memmove(index->key_offset + first, index->key_offset + from, count * sizeof(size_t));
+            memmove(index->value_offset + first, index->value_offset + from, count * sizeof(size_t));
+            memmove(index->key_len + first, index->key_len + from, count * sizeof(uint32_t));
+            memmove(index->value_len + first, index->value_len + from, count * sizeof(uint32_t));
+            memmove(index->hash + first, index->hash + from, count * sizeof(uint32_t));
+            memmove(index->section_id + first, index->section_id + from, count * sizeof(uint32_t));
+        }
+        if (section_id > 0)
+        {
+            for (size_t entry = first; entry < first + count; entry++)
+            {
+                index->section_id[entry] = kv_parse_index_section_add(index->section_id[entry], section_id);
+            }
+        }
+
+        first += count;
+        section_id = kv_parse_index_section_add(section_id, chunk[i].sections);
+    }
+}
+#endif
+
+bool kv_parse_buffer_index_parallel(kv_parse_index *index, char *str, size_t threads)
+{
+#ifdef KV_PARSE_INDEX_THREADS
+    size_t len = strlen(str);
+
+    if (threads == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (size_t)online : 1;
+    }
+
+    /* Small inputs are not worth a thread */
+    if (threads > len / KV_PARSE_INDEX_CHUNK_MIN)
+    {
+        threads = len / KV_PARSE_INDEX_CHUNK_MIN;
+    }
+    if (threads > KV_PARSE_INDEX_THREADS_MAX)
+    {
+        threads = KV_PARSE_INDEX_THREADS_MAX;
+    }
+    if (threads <= 1)
+    {
+        return kv_parse_buffer_index(index, str);
+    }
+
+    index->buffer = str;
+    index->count = 0;
+    memset(index->ctrl, KV_PARSE_INDEX_EMPTY, index->groups * KV_PARSE_INDEX_GROUP);
+
+    /* Split at newline boundaries */
+    kv_parse_index_chunk chunk[KV_PARSE_INDEX_THREADS_MAX];
+    char *start = str;
+    size_t chunks = 0;
+    for (size_t i = 0; i < threads && *start != '\0'; i++)
+    {
+        char *end = str + len;
+        if (i + 1 < threads)
+        {
+            end = str + len / threads * (i + 1);
+            if (end < start)
+            {
+                end = start;
+            }
+            end = kv_parse_buffer_scan_line(end);
+            end += (*end == '\n') ? 1 : 0;
+        }
+
+        chunk[chunks].index = index;
+        chunk[chunks].str = start;
+        chunk[chunks].end = end;
+        chunks++;
+        start = end;
+    }
+
+    /* Pass 1: tokenize concurrently, each chunk into an equal window of the entries with section ids from 0 */
+    for (size_t i = 0; i < chunks; i++)
+    {
+        chunk[i].first = index->capacity / chunks * i;
+        chunk[i].limit = (i + 1 < chunks) ? index->capacity / chunks : index->capacity - chunk[i].first;
+        chunk[i].sections = 0;
+        chunk[i].store = true;
+    }
+    kv_parse_index_chunks_run(chunk, chunks, kv_parse_index_chunk_tokenize);
+
+    size_t total = 0;
+    bool overflow = false;
+    for (size_t i = 0; i < chunks; i++)
+    {
+        total += chunk[i].count;
+        overflow = overflow || chunk[i].overflow;
+    }
+
+    if (!overflow)
+    {
+        /* Every chunk fit its window. Close the gaps between them */
+        kv_parse_index_chunks_compact(index, chunk, chunks);
+    }
+    else
+    {
+        /* Pass 2: a chunk outgrew its window. Now that every count is known, tokenize again straight into the
+           final entries. Entries past the capacity are dropped as in `kv_parse_buffer_index()` */
+        size_t first = 0;
+        uint32_t section_id = 0;
+        for (size_t i = 0; i < chunks; i++)
+        {
+            size_t count = chunk[i].count;
+            uint32_t sections = chunk[i].sections;
+            chunk[i].first = first;
+            chunk[i].limit = (first < index->capacity) ? index->capacity - first : 0;
+            chunk[i].sections = section_id;
+            first += count;
+            section_id = kv_parse_index_section_add(section_id, sections);
+        }
+        kv_parse_index_chunks_run(chunk, chunks, kv_parse_index_chunk_tokenize);
+    }
+    index->count = (total < index->capacity) ? total : index->capacity;
+    index->threads = chunks;
+
+    /* Insert concurrently, each chunk owning an equal range of hash table groups */
+    for (size_t i = 0; i < chunks; i++)
+    {
+        chunk[i].group_first = index->groups * i / chunks;
+        chunk[i].group_end = index->groups * (i + 1) / chunks;
+    }
+    kv_parse_index_chunks_run(chunk, chunks, kv_parse_index_chunk_insert);
+
+    /* Finish deferred probes in buffer order. Entries already in the table find themselves and are skipped */
+    size_t deferred = KV_PARSE_INDEX_NONE;
+    for (size_t i = 0; i < chunks; i++)
+    {
+        deferred = (chunk[i].deferred < deferred) ? chunk[i].deferred : deferred;
+    }
+    for (size_t entry = deferred; entry < index->count; entry++)
+    {
+        size_t home = kv_parse_index_home(index, index->hash[entry]);
+        for (size_t i = 0; i < chunks; i++)
+        {
+            if (home >= chunk[i].group_first && home < chunk[i].group_end)
+            {
+                if (entry >= chunk[i].deferred)
+                {
+                    kv_parse_index_insert(index, entry);
+                }
+                break;
+            }
+        }
+    }
+
+    return total <= index->capacity;
+#else
+    (void)threads;
+    return kv_parse_buffer_index(index, str);
+#endif
+}
+
+size_t kv_parse_index_get(const kv_parse_index *index, const char *key, char *value, size_t value_max)
+{
+    size_t key_len = strlen(key);
+    size_t entry = kv_parse_index_probe(index, key, key_len, kv_parse_index_hash(key, key_len), NULL);
+    if (entry == KV_PARSE_INDEX_NONE)
+    {
+        /* Key not found */
+        value[0] = '\0';
+        return 0;
+    }
+
+    /* Key Found. Extract value using the buffer parser */
+    return kv_parse_buffer_get_value(index->buffer + index->value_offset[entry], value, value_max);
+}
+
+size_t kv_parse_index_get_key(const kv_parse_index *index, const kv_key *key, char *value, size_t value_max)
+{
+    size_t entry = kv_parse_index_probe(index, key->str, key->len, kv_parse_key_mix(key->hash), NULL);
+    if (entry == KV_PARSE_INDEX_NONE)
+    {
+        /* Key not found */
+        value[0] = '\0';
+        return 0;
+    }
+
+    /* Key Found. Extract value using the buffer parser */
+    return kv_parse_buffer_get_value(index->buffer + index->value_offset[entry], value, value_max);
+}
+
+kv_parse_view kv_parse_index_get_view(const kv_parse_index *index, const char *key)
+{
+    kv_parse_view view = {NULL, 0, 0};
+
+    size_t key_len = strlen(key);
+    size_t entry = kv_parse_index_probe(index, key, key_len, kv_parse_index_hash(key, key_len), NULL);
+    if (entry == KV_PARSE_INDEX_NONE)
+    {
+        /* Key not found */
+        return view;
+    }
+
+    /* Key Found. Value span is already bounded to the line */
+    const char *value = index->buffer + index->value_offset[entry];
+    return kv_parse_span_get_value_view(value, value + index->value_len[entry]);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file kv_parse_index.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a single pass indexer for the buffer parser. The buffer is tokenized once
+ * into a table of key and value spans so that repeated key lookups do not need to rescan the buffer.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * static unsigned char storage[KV_PARSE_INDEX_BYTES(256)];
+ * kv_parse_index index;
+ * kv_parse_index_init(&index, storage, 256);
+ * kv_parse_buffer_index(&index, input);
+ * return kv_parse_index_get(&index, key, value, value_max);
+ * @endcode
+ */
+#ifndef KV_PARSE_INDEX_H
+#define KV_PARSE_INDEX_H
+
+#include "kv_parse_buffer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Control bytes probed per step. Matches one SSE2 register */
+#define KV_PARSE_INDEX_GROUP 16
+
+/* Hash table groups for n entries. Keeps the load factor at or below 7/8 */
+#define KV_PARSE_INDEX_GROUPS(n) (((n) + (n) / 7) / KV_PARSE_INDEX_GROUP + 1)
+
+/* Bytes used per entry by the span table */
+#define KV_PARSE_INDEX_ENTRY_BYTES (2 * sizeof(size_t) + 4 * sizeof(uint32_t))
+
+/* Bytes used per slot by the hash table (entry position and control byte) */
+#define KV_PARSE_INDEX_SLOT_BYTES (sizeof(uint32_t) + 1)
+
+/**
+ * @brief Storage size in bytes required by an index holding up to n entries.
+ *
+ * Includes slack so the storage array does not need any particular alignment.
+ */
+#define KV_PARSE_INDEX_BYTES(n) ((n) * KV_PARSE_INDEX_ENTRY_BYTES + KV_PARSE_INDEX_GROUPS(n) * KV_PARSE_INDEX_GROUP * KV_PARSE_INDEX_SLOT_BYTES + sizeof(size_t))
+
+/**
+ * @brief Key value span table over a buffer.
+ *
+ * Entries are stored as a struct of arrays in the order they appear in the buffer.
+ * Section id is 0 before the first `[section]` header and increments on every header seen,
+ * stopping at UINT32_MAX.
+ *
+ * Lookups use an open addressing hash table in the style of a swiss table. Each slot has a control
+ * byte holding 7 bits of the key hash (or empty), and a group of 16 control bytes is checked per probe.
+ * All arrays live in caller supplied storage sized with KV_PARSE_INDEX_BYTES().
+ */
+typedef struct kv_parse_index
+{
+    char *buffer;
+    size_t count;
+    size_t capacity;
+    size_t threads; /* Threads that tokenized the buffer in the last build. 1 for a sequential build */
+
+    /* Key Value Spans */
+    size_t *key_offset;
+    size_t *value_offset;
+    uint32_t *key_len;
+    uint32_t *value_len;
+    uint32_t *hash;
+    uint32_t *section_id;
+
+    /* Hash Table */
+    size_t groups;
+    uint32_t *slot;
+    uint8_t *ctrl;
+} kv_parse_index;
+
+/**
+ * @brief Binds an index to caller supplied storage.
+ *
+ * @param index Index to initialise.
+ * @param storage Storage of at least KV_PARSE_INDEX_BYTES(capacity) bytes. Must outlive the index.
+ * @param capacity Maximum number of key value entries the index can hold.
+ */
+void kv_parse_index_init(kv_parse_index *index, void *storage, size_t capacity);
+
+/**
+ * @brief Tokenizes a buffer into an index of key value spans.
+ *
+ * This function walks the buffer once using the same line and section rules as
+ * `kv_parse_buffer_next_line()` and `kv_parse_buffer_check_section()`, so `[]` is not a header.
+ * Each key ends at the first key value delimiter ('=' or ':') on its line and is trimmed of
+ * whitespace, as in `kv_parse_buffer_iter_next()`. Lines without a delimiter are skipped.
+ *
+ * @note `kv_parse_buffer_check_key()` also matches keys that run past the first delimiter or keep
+ *       whitespace before it, so "db:host=localhost" is found as "db:host" by a linear scan but only
+ *       as "db" (value "host=localhost") through the index.
+ *
+ * @param index Index bound to storage with `kv_parse_index_init()`. Any previous content is discarded.
+ * @param str Buffer to index. Must outlive the index as spans point into it.
+ *
+ * @return true if the whole buffer was indexed, false if it holds more entries than the index capacity.
+ *         On false the index still covers the entries up to its capacity.
+ */
+bool kv_parse_buffer_index(kv_parse_index *index, char *str);
+
+/**
+ * @brief Tokenizes a buffer into an index of key value spans using several threads.
+ *
+ * The buffer is split at newline boundaries into one chunk per thread. Each chunk tokenizes into an
+ * equal share of the capacity, then the calling thread closes the gaps and renumbers section ids.
+ * If a chunk holds more entries than its share, the buffer is read a second time with every chunk
+ * tokenizing straight into its final entries, so leave headroom in the capacity for uneven inputs.
+ * The hash table is then split into one range of groups per thread and filled concurrently. Entries
+ * whose probe would run past the range are inserted afterwards by the calling thread, which is rare
+ * at the table load factor. The result is identical to `kv_parse_buffer_index()`, including which
+ * entries are kept when the buffer holds more than the capacity.
+ *
+ * Inputs smaller than 64 KiB per thread use fewer threads. If threads are unavailable
+ * (KV_PARSE_DISABLE_THREADS or not POSIX) the buffer is indexed sequentially. `index->threads`
+ * reports how many threads were used.
+ *
+ * @param index Index bound to storage with `kv_parse_index_init()`. Any previous content is discarded.
+ * @param str Buffer to index. Must outlive the index as spans point into it.
+ * @param threads Number of threads to use, or 0 for one per online CPU. At most 64.
+ *
+ * @return true if the whole buffer was indexed, false if it holds more entries than the index capacity.
+ */
+bool kv_parse_buffer_index_parallel(kv_parse_index *index, char *str, size_t threads);
+
+/**
+ * @brief Extracts the value associated with a key using an index.
+ *
+ * Duplicate keys return the first occurrence, matching a linear scan of the buffer.
+ *
+ * @param index Index filled by `kv_parse_buffer_index()`.
+ * @param key The key to search for.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the key is missing, the value is too large or empty.
+ *
+ * @note Unless KV_PARSE_DISABLE_SIMD is defined, control bytes are matched with SSE2 when available.
+ */
+size_t kv_parse_index_get(const kv_parse_index *index, const char *key, char *value, size_t value_max);
+
+/**
+ * @brief Locates the value associated with a key using an index, without copying it.
+ *
+ * @param index Index filled by `kv_parse_buffer_index()`.
+ * @param key The key to search for.
+ *
+ * @return View of the value inside the indexed buffer. `ptr` is NULL if the key is missing.
+ */
+kv_parse_view kv_parse_index_get_view(const kv_parse_index *index, const char *key);
+
+/**
+ * @brief Extracts the value associated with a key descriptor using an index.
+ *
+ * Same as `kv_parse_index_get()` but the key length and hash come from the descriptor,
+ * so a `KV_PARSE_KEY()` lookup does no work on the key before probing.
+ *
+ * @param index Index filled by `kv_parse_buffer_index()`.
+ * @param key Key descriptor built with `KV_PARSE_KEY()` or `kv_parse_key()`.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the key is missing, the value is too large or empty.
+ */
+size_t kv_parse_index_get_key(const kv_parse_index *index, const kv_key *key, char *value, size_t value_max);
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file kv_parse_key.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains precomputed key descriptors. A descriptor holds the key, its length and
+ * its hash, so the length and hash of a string literal key are worked out by the compiler and
+ * matching can reject most mismatching keys without comparing them byte by byte.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * static const kv_key host = KV_PARSE_KEY("host");
+ * char *input_value = kv_parse_buffer_match_key(input, &host);
+ * @endcode
+ */
+#ifndef KV_PARSE_KEY_H
+#define KV_PARSE_KEY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Key descriptor.
+ *
+ * Build from a string literal with `KV_PARSE_KEY()` or from any string with `kv_parse_key()`.
+ * Both produce the same hash for the same key.
+ */
+typedef struct kv_key
+{
+    const char *str; /* Key. Need not be null terminated */
+    size_t len;
+    uint32_t hash; /* See `kv_parse_key_hash()` */
+} kv_key;
+
+/* Longest string literal accepted by `KV_PARSE_KEY()`. Longer keys use `kv_parse_key()` */
+#define KV_PARSE_KEY_HASH_BYTES 64
+
+/* Byte i of a string literal, or 0 past its length. Index is clamped so unused terms stay in bounds */
+#define KV_PARSE_KEY_BYTE(s, i) ((i) < sizeof(s) - 1 ? (uint32_t)(unsigned char)(s)[(i) < sizeof(s) - 1 ? (i) : 0] : 0u)
+
+/* Fails to compile for literals longer than KV_PARSE_KEY_HASH_BYTES, which the expression below cannot cover */
+#define KV_PARSE_KEY_FITS(s) ((uint32_t)sizeof(char[sizeof(s) - 1 <= KV_PARSE_KEY_HASH_BYTES ? 1 : -1]) * 0u)
+
+/**
+ * @brief Hash of a string literal as a constant expression. Matches `kv_parse_key_hash()`.
+ *
+ * Every byte of the key is multiplied by its own odd constant and summed, so each term is independent
+ * and the expression stays flat. Keys differing in any single byte always differ in hash.
+ */
+#define KV_PARSE_KEY_HASH(s) \
+    (KV_PARSE_KEY_FITS(s) + (uint32_t)(sizeof(s) - 1) * 0x27D4EB2Fu \
+     + KV_PARSE_KEY_BYTE(s, 0) * 0x71F6D501u \
+     + KV_PARSE_KEY_BYTE(s, 1) * 0x0E005891u \
+     + KV_PARSE_KEY_BYTE(s, 2) * 0x8E468635u \
+     + KV_PARSE_KEY_BYTE(s, 3) * 0xF3FA6DC5u \
+     + KV_PARSE_KEY_BYTE(s, 4) * 0x39F27A27u \
+     + KV_PARSE_KEY_BYTE(s, 5) * 0x53D20B1Bu \
+     + KV_PARSE_KEY_BYTE(s, 6) * 0x84BF3B07u \
+     + KV_PARSE_KEY_BYTE(s, 7) * 0x4DDF3195u \
+     + KV_PARSE_KEY_BYTE(s, 8) * 0x69E2A9CDu \
+     + KV_PARSE_KEY_BYTE(s, 9) * 0x9A7BB019u \
+     + KV_PARSE_KEY_BYTE(s, 10) * 0xC7CDBFE3u \
+     + KV_PARSE_KEY_BYTE(s, 11) * 0x7E78C191u \
+     + KV_PARSE_KEY_BYTE(s, 12) * 0xCF9901ADu \
+     + KV_PARSE_KEY_BYTE(s, 13) * 0xB017E557u \
+     + KV_PARSE_KEY_BYTE(s, 14) * 0x5630EBCBu \
+     + KV_PARSE_KEY_BYTE(s, 15) * 0x00919B8Du \
+     + KV_PARSE_KEY_BYTE(s, 16) * 0xF355A1ABu \
+     + KV_PARSE_KEY_BYTE(s, 17) * 0x1EF5FA7Du \
+     + KV_PARSE_KEY_BYTE(s, 18) * 0xAB60C9BDu \
+     + KV_PARSE_KEY_BYTE(s, 19) * 0xDF47C655u \
+     + KV_PARSE_KEY_BYTE(s, 20) * 0x2050DE07u \
+     + KV_PARSE_KEY_BYTE(s, 21) * 0x25140E03u \
+     + KV_PARSE_KEY_BYTE(s, 22) * 0xA30100EBu \
+     + KV_PARSE_KEY_BYTE(s, 23) * 0x9B86ECC7u \
+     + KV_PARSE_KEY_BYTE(s, 24) * 0x5CB60427u \
+     + KV_PARSE_KEY_BYTE(s, 25) * 0x9191C6EFu \
+     + KV_PARSE_KEY_BYTE(s, 26) * 0x7652BA19u \
+     + KV_PARSE_KEY_BYTE(s, 27) * 0xBAC3B577u \
+     + KV_PARSE_KEY_BYTE(s, 28) * 0x36BCBD03u \
+     + KV_PARSE_KEY_BYTE(s, 29) * 0x64CCB203u \
+     + KV_PARSE_KEY_BYTE(s, 30) * 0xA84E7D19u \
+     + KV_PARSE_KEY_BYTE(s, 31) * 0x8FDFB68Bu \
+     + KV_PARSE_KEY_BYTE(s, 32) * 0xEB7795A1u \
+     + KV_PARSE_KEY_BYTE(s, 33) * 0x6685DB1Bu \
+     + KV_PARSE_KEY_BYTE(s, 34) * 0x9C2EC8A1u \
+     + KV_PARSE_KEY_BYTE(s, 35) * 0xC1B9E9FBu \
+     + KV_PARSE_KEY_BYTE(s, 36) * 0xEE88D4A1u \
+     + KV_PARSE_KEY_BYTE(s, 37) * 0x456CB70Du \
+     + KV_PARSE_KEY_BYTE(s, 38) * 0xFF7DC383u \
+     + KV_PARSE_KEY_BYTE(s, 39) * 0xF8684C41u \
+     + KV_PARSE_KEY_BYTE(s, 40) * 0xFE3042A3u \
+     + KV_PARSE_KEY_BYTE(s, 41) * 0x387521C3u \
+     + KV_PARSE_KEY_BYTE(s, 42) * 0x7B821BB9u \
+     + KV_PARSE_KEY_BYTE(s, 43) * 0xAE28B9FDu \
+     + KV_PARSE_KEY_BYTE(s, 44) * 0xC50F7861u \
+     + KV_PARSE_KEY_BYTE(s, 45) * 0xDD6B51F1u \
+     + KV_PARSE_KEY_BYTE(s, 46) * 0x9EE7535Bu \
+     + KV_PARSE_KEY_BYTE(s, 47) * 0x58B04B7Du \
+     + KV_PARSE_KEY_BYTE(s, 48) * 0x9468CB29u \
+     + KV_PARSE_KEY_BYTE(s, 49) * 0x3CFFE7F7u \
+     + KV_PARSE_KEY_BYTE(s, 50) * 0x18AFBA25u \
+     + KV_PARSE_KEY_BYTE(s, 51) * 0xB08BACDBu \
+     + KV_PARSE_KEY_BYTE(s, 52) * 0xA3D5B465u \
+     + KV_PARSE_KEY_BYTE(s, 53) * 0x805EE11Fu \
+     + KV_PARSE_KEY_BYTE(s, 54) * 0x4605D77Fu \
+     + KV_PARSE_KEY_BYTE(s, 55) * 0x0843B9E9u \
+     + KV_PARSE_KEY_BYTE(s, 56) * 0x0219CE49u \
+     + KV_PARSE_KEY_BYTE(s, 57) * 0x6146F99Fu \
+     + KV_PARSE_KEY_BYTE(s, 58) * 0x1B0837BBu \
+     + KV_PARSE_KEY_BYTE(s, 59) * 0xFA37456Fu \
+     + KV_PARSE_KEY_BYTE(s, 60) * 0x14DC9653u \
+     + KV_PARSE_KEY_BYTE(s, 61) * 0x9CCC7E87u \
+     + KV_PARSE_KEY_BYTE(s, 62) * 0xEA447E7Du \
+     + KV_PARSE_KEY_BYTE(s, 63) * 0x89D69C35u)
+
+/**
+ * @brief Initializer for a key descriptor of a string literal, computed at compile time.
+ *
+ * `static const kv_key port = KV_PARSE_KEY("port");`
+ */
+#define KV_PARSE_KEY(s) {(s), sizeof(s) - 1, KV_PARSE_KEY_HASH(s)}
+
+/**
+ * @brief Hashes a key. Matches `KV_PARSE_KEY_HASH()`.
+ *
+ * Every byte is hashed. The first KV_PARSE_KEY_HASH_BYTES bytes use the same sum as the
+ * compile time hash, and bytes past them are folded in with FNV-1a steps.
+ *
+ * @param str Key.
+ * @param len Length of the key.
+ *
+ * @return Hash of the key.
+ */
+static inline uint32_t kv_parse_key_hash(const char *str, size_t len)
+{
+    static const uint32_t mul[KV_PARSE_KEY_HASH_BYTES] = {
+        0x71F6D501u, 0x0E005891u, 0x8E468635u, 0xF3FA6DC5u,
+        0x39F27A27u, 0x53D20B1Bu, 0x84BF3B07u, 0x4DDF3195u,
+        0x69E2A9CDu, 0x9A7BB019u, 0xC7CDBFE3u, 0x7E78C191u,
+        0xCF9901ADu, 0xB017E557u, 0x5630EBCBu, 0x00919B8Du,
+        0xF355A1ABu, 0x1EF5FA7Du, 0xAB60C9BDu, 0xDF47C655u,
+        0x2050DE07u, 0x25140E03u, 0xA30100EBu, 0x9B86ECC7u,
+        0x5CB60427u, 0x9191C6EFu, 0x7652BA19u, 0xBAC3B577u,
+        0x36BCBD03u, 0x64CCB203u, 0xA84E7D19u, 0x8FDFB68Bu,
+        0xEB7795A1u, 0x6685DB1Bu, 0x9C2EC8A1u, 0xC1B9E9FBu,
+        0xEE88D4A1u, 0x456CB70Du, 0xFF7DC383u, 0xF8684C41u,
+        0xFE3042A3u, 0x387521C3u, 0x7B821BB9u, 0xAE28B9FDu,
+        0xC50F7861u, 0xDD6B51F1u, 0x9EE7535Bu, 0x58B04B7Du,
+        0x9468CB29u, 0x3CFFE7F7u, 0x18AFBA25u, 0xB08BACDBu,
+        0xA3D5B465u, 0x805EE11Fu, 0x4605D77Fu, 0x0843B9E9u,
+        0x0219CE49u, 0x6146F99Fu, 0x1B0837BBu, 0xFA37456Fu,
+        0x14DC9653u, 0x9CCC7E87u, 0xEA447E7Du, 0x89D69C35u,
+    };
+
+    uint32_t hash = (uint32_t)len * 0x27D4EB2Fu;
+    size_t i = 0;
+    for (; i < KV_PARSE_KEY_HASH_BYTES && i < len; i++)
+    {
+        hash += (uint32_t)(unsigned char)str[i] * mul[i];
+    }
+    for (; i < len; i++)
+    {
+        hash = (hash ^ (unsigned char)str[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finalizes a key hash so every hashed byte reaches every output bit.
+ *
+ * `kv_parse_key_hash()` is linear in the key bytes, so its low bits alone make poor table
+ * positions. Hash tables and filters over keys mix the hash with this before using it.
+ *
+ * @param hash Hash from `kv_parse_key_hash()` or a key descriptor.
+ *
+ * @return Mixed hash.
+ */
+static inline uint32_t kv_parse_key_mix(uint32_t hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ * @brief Builds a key descriptor at runtime.
+ *
+ * @param str Null terminated key. Must outlive the descriptor.
+ *
+ * @return Descriptor of the key.
+ */
+static inline kv_key kv_parse_key(const char *str)
+{
+    kv_key key;
+    key.str = str;
+    for (key.len = 0; str[key.len] != '\0'; key.len++)
+    {
+    }
+    key.hash = kv_parse_key_hash(str, key.len);
+    return key;
+}
+
+#endif
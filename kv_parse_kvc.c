@@ -0,0 +1,364 @@
+/**
+ * @file kv_parse_kvc.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a compiled binary config format. A text buffer is compiled once into a
+ * position independent image holding a prehashed table and a pool of decoded keys and values.
+ * Lookups in the image probe the table and compare one key, without parsing any text.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "kv_parse_kvc.h"
+#include "kv_parse_buffer.h"
+#include "kv_parse_key.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Header fields, as 32 bit word numbers */
+enum
+{
+    KV_PARSE_KVC_MAGIC,
+    KV_PARSE_KVC_FORMAT,
+    KV_PARSE_KVC_COUNT,
+    KV_PARSE_KVC_SLOTS,
+    KV_PARSE_KVC_ENTRIES,
+    KV_PARSE_KVC_POOL,
+    KV_PARSE_KVC_POOL_SIZE,
+    KV_PARSE_KVC_SIZE,
+};
+
+/* Bytes of a table slot and of an entry */
+#define KV_PARSE_KVC_SLOT_BYTES 8
+#define KV_PARSE_KVC_ENTRY_BYTES 16
+
+/* Largest image offset */
+#define KV_PARSE_KVC_MAX 0xFFFFFFFFu
+
+static const unsigned char kv_parse_kvc_magic[4] = {'K', 'V', 'C', '1'};
+
+/* Integers are little endian and read bytewise so images need no alignment and work on any host */
+static uint32_t kv_parse_kvc_load(const unsigned char *ptr)
+{
+    return (uint32_t)ptr[0] | (uint32_t)ptr[1] << 8 | (uint32_t)ptr[2] << 16 | (uint32_t)ptr[3] << 24;
+}
+
+static void kv_parse_kvc_store(unsigned char *ptr, uint32_t value)
+{
+    ptr[0] = (unsigned char)value;
+    ptr[1] = (unsigned char)(value >> 8);
+    ptr[2] = (unsigned char)(value >> 16);
+    ptr[3] = (unsigned char)(value >> 24);
+}
+
+/**
+ * Probes the table of a bound image. Returns the entry of the key, or NULL if missing.
+ * Stored offsets are checked against the pool so a corrupt image cannot read out of bounds.
+ */
+static const unsigned char *kv_parse_kvc_probe(const kv_parse_kvc *kvc, const char *key, size_t key_len, uint32_t hash)
+{
+    uint32_t mask = kvc->slots - 1;
+    uint32_t slot = hash & mask;
+
+    for (uint32_t probes = 0; probes < kvc->slots; probes++, slot = (slot + 1) & mask)
+    {
+        const unsigned char *ptr = kvc->table + (size_t)slot * KV_PARSE_KVC_SLOT_BYTES;
+        uint32_t entry = kv_parse_kvc_load(ptr + 4);
+        if (entry == 0)
+        {
+            /* An empty slot ends the probe sequence. Key is not in the table */
+            return NULL;
+        }
+
+        if (kv_parse_kvc_load(ptr) != hash || entry > kvc->count)
+        {
+            continue;
+        }
+
+        const unsigned char *rec = kvc->entries + (size_t)(entry - 1) * KV_PARSE_KVC_ENTRY_BYTES;
+        uint32_t key_off = kv_parse_kvc_load(rec);
+        uint32_t stored_len = kv_parse_kvc_load(rec + 4);
+        if (stored_len == key_len && key_off <= kvc->pool_size && key_len <= kvc->pool_size - key_off && memcmp(kvc->pool + key_off, key, key_len) == 0)
+        {
+            uint32_t value_off = kv_parse_kvc_load(rec + 8);
+            uint32_t value_len = kv_parse_kvc_load(rec + 12);
+            if (value_off > kvc->pool_size || value_len >= kvc->pool_size - value_off)
+            {
+                /* Value and its terminator must be inside the pool */
+                return NULL;
+            }
+            return rec;
+        }
+    }
+
+    return NULL;
+}
+
+size_t kv_parse_kvc_compile(const char *str, void *image, size_t image_max)
+{
+    kv_parse_buffer_iter it;
+    kv_parse_record rec;
+
+    /* First pass. Count records and bound the pool, as values only shrink when decoded */
+    size_t count = 0;
+    size_t pool_max = 0;
+    kv_parse_buffer_iter_init(&it, str);
+    while (kv_parse_buffer_iter_next(&it, &rec))
+    {
+        count++;
+        pool_max += rec.key_len + rec.value.len + 2;
+    }
+
+    size_t slots = 1;
+    while (slots < count * 2)
+    {
+        slots *= 2;
+    }
+
+    size_t table = KV_PARSE_KVC_HEADER_BYTES;
+    size_t entries = table + slots * KV_PARSE_KVC_SLOT_BYTES;
+    size_t pool = entries + count * KV_PARSE_KVC_ENTRY_BYTES;
+    if (slots > KV_PARSE_KVC_MAX / KV_PARSE_KVC_SLOT_BYTES || count > KV_PARSE_KVC_MAX / KV_PARSE_KVC_ENTRY_BYTES || pool > KV_PARSE_KVC_MAX || pool_max > KV_PARSE_KVC_MAX - pool)
+    {
+        /* Offsets would not fit in 32 bits */
+        return 0;
+    }
+
+    if (image == NULL)
+    {
+        return pool + pool_max;
+    }
+
+    if (image_max < pool)
+    {
+        return 0;
+    }
+
+    unsigned char *out = (unsigned char *)image;
+    memset(out, 0, pool);
+
+    /* Second pass. Insert each new key into the table and append it to the pool */
+    size_t unique = 0;
+    size_t pool_len = 0;
+    size_t pool_room = image_max - pool;
+    kv_parse_buffer_iter_init(&it, str);
+    while (kv_parse_buffer_iter_next(&it, &rec))
+    {
+        uint32_t hash = kv_parse_key_mix(kv_parse_key_hash(rec.key, rec.key_len));
+        size_t slot = hash & (slots - 1);
+        bool duplicate = false;
+
+        while (kv_parse_kvc_load(out + table + slot * KV_PARSE_KVC_SLOT_BYTES + 4) != 0)
+        {
+            const unsigned char *ptr = out + table + slot * KV_PARSE_KVC_SLOT_BYTES;
+            const unsigned char *old = out + entries + (kv_parse_kvc_load(ptr + 4) - 1) * KV_PARSE_KVC_ENTRY_BYTES;
+            if (kv_parse_kvc_load(ptr) == hash && kv_parse_kvc_load(old + 4) == rec.key_len && memcmp(out + pool + kv_parse_kvc_load(old), rec.key, rec.key_len) == 0)
+            {
+                /* Duplicate key. First occurrence wins */
+                duplicate = true;
+                break;
+            }
+            slot = (slot + 1) & (slots - 1);
+        }
+
+        if (duplicate)
+        {
+            continue;
+        }
+
+        /* Key */
+        if (rec.key_len + 1 > pool_room - pool_len)
+        {
+            return 0;
+        }
+        unsigned char *entry = out + entries + unique * KV_PARSE_KVC_ENTRY_BYTES;
+        kv_parse_kvc_store(entry, (uint32_t)pool_len);
+        kv_parse_kvc_store(entry + 4, (uint32_t)rec.key_len);
+        memcpy(out + pool + pool_len, rec.key, rec.key_len);
+        out[pool + pool_len + rec.key_len] = '\0';
+        pool_len += rec.key_len + 1;
+
+        /* Decoded value */
+        size_t value_len = rec.value.len;
+        if (value_len + 1 > pool_room - pool_len)
+        {
+            return 0;
+        }
+        if (value_len > 0)
+        {
+            value_len = kv_parse_view_unescape(rec.value, (char *)out + pool + pool_len, value_len + 1);
+        }
+        out[pool + pool_len + value_len] = '\0';
+        kv_parse_kvc_store(entry + 8, (uint32_t)pool_len);
+        kv_parse_kvc_store(entry + 12, (uint32_t)value_len);
+        pool_len += value_len + 1;
+
+        kv_parse_kvc_store(out + table + slot * KV_PARSE_KVC_SLOT_BYTES, hash);
+        kv_parse_kvc_store(out + table + slot * KV_PARSE_KVC_SLOT_BYTES + 4, (uint32_t)(unique + 1));
+        unique++;
+    }
+
+    /* Close the gap left by duplicate keys. Pool offsets are relative so stay valid */
+    size_t pool_start = entries + unique * KV_PARSE_KVC_ENTRY_BYTES;
+    memmove(out + pool_start, out + pool, pool_len);
+
+    memcpy(out, kv_parse_kvc_magic, sizeof(kv_parse_kvc_magic));
+    kv_parse_kvc_store(out + KV_PARSE_KVC_FORMAT * 4, KV_PARSE_KVC_VERSION);
+    kv_parse_kvc_store(out + KV_PARSE_KVC_COUNT * 4, (uint32_t)unique);
+    kv_parse_kvc_store(out + KV_PARSE_KVC_SLOTS * 4, (uint32_t)slots);
+    kv_parse_kvc_store(out + KV_PARSE_KVC_ENTRIES * 4, (uint32_t)entries);
+    kv_parse_kvc_store(out + KV_PARSE_KVC_POOL * 4, (uint32_t)pool_start);
+    kv_parse_kvc_store(out + KV_PARSE_KVC_POOL_SIZE * 4, (uint32_t)pool_len);
+    kv_parse_kvc_store(out + KV_PARSE_KVC_SIZE * 4, (uint32_t)(pool_start + pool_len));
+    return pool_start + pool_len;
+}
+
+bool kv_parse_kvc_bind(kv_parse_kvc *kvc, const void *image, size_t size)
+{
+    const unsigned char *ptr = (const unsigned char *)image;
+
+    kvc->image = NULL;
+    kvc->size = 0;
+    kvc->map = NULL;
+    kvc->map_size = 0;
+
+    if (size < KV_PARSE_KVC_HEADER_BYTES || memcmp(ptr, kv_parse_kvc_magic, sizeof(kv_parse_kvc_magic)) != 0 || kv_parse_kvc_load(ptr + KV_PARSE_KVC_FORMAT * 4) != KV_PARSE_KVC_VERSION)
+    {
+        /* Not an image, or from another format version */
+        return false;
+    }
+
+    uint64_t count = kv_parse_kvc_load(ptr + KV_PARSE_KVC_COUNT * 4);
+    uint64_t slots = kv_parse_kvc_load(ptr + KV_PARSE_KVC_SLOTS * 4);
+    uint64_t entries = kv_parse_kvc_load(ptr + KV_PARSE_KVC_ENTRIES * 4);
+    uint64_t pool = kv_parse_kvc_load(ptr + KV_PARSE_KVC_POOL * 4);
+    uint64_t pool_size = kv_parse_kvc_load(ptr + KV_PARSE_KVC_POOL_SIZE * 4);
+    uint64_t image_size = kv_parse_kvc_load(ptr + KV_PARSE_KVC_SIZE * 4);
+
+    /* Sections must be in order and inside the image. Slots are a power of two */
+    if (slots == 0 || (slots & (slots - 1)) != 0 || entries < KV_PARSE_KVC_HEADER_BYTES + slots * KV_PARSE_KVC_SLOT_BYTES || pool < entries + count * KV_PARSE_KVC_ENTRY_BYTES ||
+        image_size < pool + pool_size || image_size > size)
+    {
+        return false;
+    }
+
+    kvc->image = ptr;
+    kvc->size = size;
+    kvc->count = (uint32_t)count;
+    kvc->slots = (uint32_t)slots;
+    kvc->table = ptr + KV_PARSE_KVC_HEADER_BYTES;
+    kvc->entries = ptr + entries;
+    kvc->pool = ptr + pool;
+    kvc->pool_size = (uint32_t)pool_size;
+    return true;
+}
+
+bool kv_parse_kvc_open(kv_parse_kvc *kvc, const char *path)
+{
+    struct stat st;
+
+    kvc->image = NULL;
+    kvc->size = 0;
+    kvc->map = NULL;
+    kvc->map_size = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < KV_PARSE_KVC_HEADER_BYTES)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    if (!kv_parse_kvc_bind(kvc, data, (size_t)st.st_size))
+    {
+        munmap(data, (size_t)st.st_size);
+        return false;
+    }
+
+    /* A lookup touches a slot, an entry and the pool, scattered over the image. Don't read ahead */
+    posix_madvise(data, (size_t)st.st_size, POSIX_MADV_RANDOM);
+
+    kvc->map = data;
+    kvc->map_size = (size_t)st.st_size;
+    return true;
+}
+
+void kv_parse_kvc_close(kv_parse_kvc *kvc)
+{
+    if (kvc->map != NULL)
+    {
+        munmap(kvc->map, kvc->map_size);
+    }
+
+    kvc->image = NULL;
+    kvc->size = 0;
+    kvc->map = NULL;
+    kvc->map_size = 0;
+}
+
+kv_parse_view kv_parse_kvc_get_view(const kv_parse_kvc *kvc, const char *key)
+{
+    kv_parse_view view = {NULL, 0, 0};
+
+    size_t key_len = strlen(key);
+    const unsigned char *rec = kv_parse_kvc_probe(kvc, key, key_len, kv_parse_key_mix(kv_parse_key_hash(key, key_len)));
+    if (rec == NULL)
+    {
+        /* Key not found */
+        return view;
+    }
+
+    /* Key Found. Value is stored decoded */
+    view.ptr = (const char *)kvc->pool + kv_parse_kvc_load(rec + 8);
+    view.len = kv_parse_kvc_load(rec + 12);
+    return view;
+}
+
+size_t kv_parse_kvc_get(const kv_parse_kvc *kvc, const char *key, char *value, size_t value_max)
+{
+    kv_parse_view view = kv_parse_kvc_get_view(kvc, key);
+    if (view.ptr == NULL)
+    {
+        /* Key not found */
+        value[0] = '\0';
+        return 0;
+    }
+
+    return kv_parse_view_unescape(view, value, value_max);
+}
+
+size_t kv_parse_kvc_get_key(const kv_parse_kvc *kvc, const kv_key *key, char *value, size_t value_max)
+{
+    const unsigned char *rec = kv_parse_kvc_probe(kvc, key->str, key->len, kv_parse_key_mix(key->hash));
+    if (rec == NULL)
+    {
+        /* Key not found */
+        value[0] = '\0';
+        return 0;
+    }
+
+    kv_parse_view view = {(const char *)kvc->pool + kv_parse_kvc_load(rec + 8), kv_parse_kvc_load(rec + 12), 0};
+    return kv_parse_view_unescape(view, value, value_max);
+}
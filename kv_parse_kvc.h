@@ -0,0 +1,150 @@
+/**
+ * @file kv_parse_kvc.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a compiled binary config format. A text buffer accepted by the buffer parser
+ * is compiled once into a position independent image holding a prehashed table and a pool of
+ * decoded keys and values (in the spirit of cdb). Readers map the image and answer each lookup with
+ * a hash probe and a key compare, without parsing any text.
+ *
+ * Image layout, all integers 32 bit little endian and all offsets from the start of the image:
+ *   Header   "KVC1" magic, version, entry count, slot count, entries offset, pool offset, pool size, image size
+ *   Table    slot count (power of two) x {key hash, entry number + 1 or 0 when empty}, linear probing
+ *   Entries  entry count x {key offset, key length, value offset, value length}, offsets into the pool
+ *   Pool     null terminated keys and decoded values
+ *
+ * Requires POSIX `mmap()` for `kv_parse_kvc_open()`.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * kv_parse_kvc kvc;
+ * if (kv_parse_kvc_open(&kvc, "settings.kvc"))
+ * {
+ *     size_t value_len = kv_parse_kvc_get(&kvc, key, value, value_max);
+ *     kv_parse_kvc_close(&kvc);
+ * }
+ * @endcode
+ */
+#ifndef KV_PARSE_KVC_H
+#define KV_PARSE_KVC_H
+
+#include "kv_parse_buffer.h"
+#include "kv_parse_key.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Image format version written by `kv_parse_kvc_compile()` */
+#define KV_PARSE_KVC_VERSION 2
+
+/* Bytes of the image header */
+#define KV_PARSE_KVC_HEADER_BYTES 32
+
+/**
+ * @brief Compiled image bound for lookups.
+ *
+ * Pointers are into the image, which is either caller supplied or inside the file mapping `map`.
+ */
+typedef struct kv_parse_kvc
+{
+    const unsigned char *image;
+    size_t size;
+
+    /* File mapping released by `kv_parse_kvc_close()`, NULL for bound images */
+    void *map;
+    size_t map_size;
+
+    /* Sections */
+    uint32_t count;
+    uint32_t slots;
+    const unsigned char *table;
+    const unsigned char *entries;
+    const unsigned char *pool;
+    uint32_t pool_size;
+} kv_parse_kvc;
+
+/**
+ * @brief Compiles a key value buffer into a binary image.
+ *
+ * Lines follow the same rules as `kv_parse_buffer_iter_next()`. Values are stored decoded, with
+ * quotes, escapes and surrounding whitespace already removed. Duplicate keys keep the first
+ * occurrence, matching a linear scan of the buffer. Sections do not scope keys.
+ *
+ * @param str Buffer to compile.
+ * @param image Buffer to write the image to, or NULL to only compute the size needed.
+ * @param image_max Size of the image buffer.
+ *
+ * @return The size of the written image. With image NULL, an upper bound of the image size.
+ *         0 if the image does not fit in image_max or the buffer is too large for 32 bit offsets.
+ */
+size_t kv_parse_kvc_compile(const char *str, void *image, size_t image_max);
+
+/**
+ * @brief Binds a compiled image in memory for lookups.
+ *
+ * @param kvc Reader to initialise.
+ * @param image Image written by `kv_parse_kvc_compile()`. Must outlive the reader. Needs no particular alignment.
+ * @param size Size of the image in bytes.
+ *
+ * @return true if the header is valid, false if the image is malformed or from another format version.
+ */
+bool kv_parse_kvc_bind(kv_parse_kvc *kvc, const void *image, size_t size);
+
+/**
+ * @brief Maps a compiled image file read only and binds it for lookups.
+ *
+ * @param kvc Reader to initialise.
+ * @param path Path of the image file.
+ *
+ * @return true if the file was mapped and holds a valid image, false otherwise.
+ */
+bool kv_parse_kvc_open(kv_parse_kvc *kvc, const char *path);
+
+/**
+ * @brief Unmaps an image opened with `kv_parse_kvc_open()` or `kv_parse_kvidx_open()`. Does nothing for bound images.
+ *
+ * @param kvc Reader to close.
+ */
+void kv_parse_kvc_close(kv_parse_kvc *kvc);
+
+/**
+ * @brief Extracts the value associated with a key from a compiled image.
+ *
+ * @param kvc Reader bound with `kv_parse_kvc_bind()` or `kv_parse_kvc_open()`.
+ * @param key The key to search for.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the key is missing, the value is too large or empty.
+ */
+size_t kv_parse_kvc_get(const kv_parse_kvc *kvc, const char *key, char *value, size_t value_max);
+
+/**
+ * @brief Locates the value associated with a key in a compiled image, without copying it.
+ *
+ * @param kvc Reader bound with `kv_parse_kvc_bind()` or `kv_parse_kvc_open()`.
+ * @param key The key to search for.
+ *
+ * @return View of the decoded value inside the image, followed by a '\0'. `ptr` is NULL if the key is missing.
+ */
+kv_parse_view kv_parse_kvc_get_view(const kv_parse_kvc *kvc, const char *key);
+
+/**
+ * @brief Extracts the value associated with a key descriptor from a compiled image.
+ *
+ * Same as `kv_parse_kvc_get()` but the key hash comes from the descriptor, so literal keys built
+ * with `KV_PARSE_KEY()` are not hashed again on every lookup.
+ *
+ * @param kvc Reader bound with `kv_parse_kvc_bind()` or `kv_parse_kvc_open()`.
+ * @param key Key descriptor to search for.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the key is missing, the value is too large or empty.
+ */
+size_t kv_parse_kvc_get_key(const kv_parse_kvc *kvc, const kv_key *key, char *value, size_t value_max);
+
+#endif
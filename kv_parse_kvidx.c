@@ -0,0 +1,351 @@
+/**
+ * @file kv_parse_kvidx.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a persistent sidecar cache for key value files. Each sidecar holds the compiled
+ * image of its source file and the source identity it was built from, so startup can map a prebuilt
+ * table instead of tokenizing the text.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "kv_parse_kvidx.h"
+#include "kv_parse_class.h"
+#include "kv_parse_kvc.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#define KV_PARSE_KVIDX_MTIME_NSEC(st) ((st).st_mtimespec.tv_nsec)
+#else
+#define KV_PARSE_KVIDX_MTIME_NSEC(st) ((st).st_mtim.tv_nsec)
+#endif
+
+/* Header fields, as byte offsets */
+enum
+{
+    KV_PARSE_KVIDX_MAGIC = 0,
+    KV_PARSE_KVIDX_FORMAT = 4,
+    KV_PARSE_KVIDX_CONFIG = 8,
+    KV_PARSE_KVIDX_SIZE = 16,
+    KV_PARSE_KVIDX_MTIME = 24,
+    KV_PARSE_KVIDX_MTIME_NSEC = 32,
+    KV_PARSE_KVIDX_INODE = 40,
+    KV_PARSE_KVIDX_HASH = 48,
+};
+
+static const unsigned char kv_parse_kvidx_magic[4] = {'K', 'V', 'I', 'X'};
+
+/* Header integers are little endian */
+static uint64_t kv_parse_kvidx_get(const unsigned char *ptr, size_t bytes)
+{
+    uint64_t value = 0;
+    while (bytes-- > 0)
+    {
+        value = value << 8 | ptr[bytes];
+    }
+    return value;
+}
+
+static void kv_parse_kvidx_put(unsigned char *ptr, uint64_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i++)
+    {
+        ptr[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/* Parser options that change the compiled image. Sidecars built with other options are stale */
+static uint32_t kv_parse_kvidx_config(void)
+{
+    uint32_t config = 0;
+#ifdef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    config |= 0x01;
+#endif
+#ifdef KV_PARSE_DISABLE_QUOTED_STRINGS
+    config |= 0x02;
+#endif
+
+    /* Delimiters decide which lines are records */
+    uint32_t delimiters = 0;
+    for (int ch = 1; ch < 256; ch++)
+    {
+        if (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_DELIMITER))
+        {
+            delimiters = delimiters * 31 + (uint32_t)ch;
+        }
+    }
+    return config | delimiters << 8;
+}
+
+/* Content hash of the source. Words are folded in with a multiply so one pass runs near memory speed */
+static uint64_t kv_parse_kvidx_hash(const unsigned char *data, size_t len)
+{
+    uint64_t hash = 0x9E3779B97F4A7C15u ^ (uint64_t)len;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDu;
+        hash ^= hash >> 32;
+    }
+
+    uint64_t tail = 0;
+    for (; i < len; i++)
+    {
+        tail = tail << 8 | data[i];
+    }
+    hash = (hash ^ tail) * 0xC4CEB9FE1A85EC53u;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+static bool kv_parse_kvidx_path(char *sidecar, const char *path, const char *suffix)
+{
+    size_t path_len = strlen(path);
+    size_t suffix_len = strlen(suffix);
+    if (path_len + suffix_len >= KV_PARSE_KVIDX_PATH_MAX)
+    {
+        return false;
+    }
+
+    memcpy(sidecar, path, path_len);
+    memcpy(sidecar + path_len, suffix, suffix_len + 1);
+    return true;
+}
+
+/* Writes the identity of the source into a sidecar header */
+static void kv_parse_kvidx_header(unsigned char *header, const struct stat *st, uint64_t hash)
+{
+    memset(header, 0, KV_PARSE_KVIDX_HEADER_BYTES);
+    memcpy(header + KV_PARSE_KVIDX_MAGIC, kv_parse_kvidx_magic, sizeof(kv_parse_kvidx_magic));
+    kv_parse_kvidx_put(header + KV_PARSE_KVIDX_FORMAT, KV_PARSE_KVIDX_VERSION, 4);
+    kv_parse_kvidx_put(header + KV_PARSE_KVIDX_CONFIG, kv_parse_kvidx_config(), 4);
+    kv_parse_kvidx_put(header + KV_PARSE_KVIDX_SIZE, (uint64_t)st->st_size, 8);
+    kv_parse_kvidx_put(header + KV_PARSE_KVIDX_MTIME, (uint64_t)st->st_mtime, 8);
+    kv_parse_kvidx_put(header + KV_PARSE_KVIDX_MTIME_NSEC, (uint64_t)KV_PARSE_KVIDX_MTIME_NSEC(*st), 8);
+    kv_parse_kvidx_put(header + KV_PARSE_KVIDX_INODE, (uint64_t)st->st_ino, 8);
+    kv_parse_kvidx_put(header + KV_PARSE_KVIDX_HASH, hash, 8);
+}
+
+/* Hashes the current content of the source */
+static bool kv_parse_kvidx_source_hash(const char *path, size_t size, uint64_t *hash)
+{
+    if (size == 0)
+    {
+        *hash = kv_parse_kvidx_hash(NULL, 0);
+        return true;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    *hash = kv_parse_kvidx_hash((const unsigned char *)data, size);
+    munmap(data, size);
+    return true;
+}
+
+bool kv_parse_kvidx_load(kv_parse_kvc *kvc, const char *path)
+{
+    char sidecar[KV_PARSE_KVIDX_PATH_MAX];
+    struct stat source;
+    struct stat st;
+
+    kvc->image = NULL;
+    kvc->size = 0;
+    kvc->map = NULL;
+    kvc->map_size = 0;
+
+    if (stat(path, &source) != 0 || !S_ISREG(source.st_mode) || !kv_parse_kvidx_path(sidecar, path, KV_PARSE_KVIDX_SUFFIX))
+    {
+        return false;
+    }
+
+    int fd = open(sidecar, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < KV_PARSE_KVIDX_HEADER_BYTES + KV_PARSE_KVC_HEADER_BYTES)
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    /* Compare the recorded identity with the source as it is now */
+    const unsigned char *header = (const unsigned char *)data;
+    unsigned char expected[KV_PARSE_KVIDX_HEADER_BYTES];
+    kv_parse_kvidx_header(expected, &source, kv_parse_kvidx_get(header + KV_PARSE_KVIDX_HASH, 8));
+    bool fresh = memcmp(header, expected, KV_PARSE_KVIDX_HEADER_BYTES) == 0;
+
+    if (fresh && source.st_mtime >= st.st_mtime)
+    {
+        /* Source changed in the same second the sidecar was written. A later change may not show in the mtime */
+        uint64_t hash = 0;
+        fresh = kv_parse_kvidx_source_hash(path, (size_t)source.st_size, &hash) && hash == kv_parse_kvidx_get(header + KV_PARSE_KVIDX_HASH, 8);
+    }
+
+    if (!fresh || !kv_parse_kvc_bind(kvc, header + KV_PARSE_KVIDX_HEADER_BYTES, size - KV_PARSE_KVIDX_HEADER_BYTES))
+    {
+        munmap(data, size);
+        return false;
+    }
+
+    kvc->map = data;
+    kvc->map_size = size;
+    return true;
+}
+
+/**
+ * Reads the source into the temporary file after the header and compiles it there. The text is null
+ * terminated in place and the image is compiled after it, then moved down to follow the header.
+ * Returns the sidecar size, or 0 on failure.
+ */
+static size_t kv_parse_kvidx_compile(int fd, int source_fd, const struct stat *source)
+{
+    size_t text_size = (size_t)source->st_size;
+    size_t text_end = KV_PARSE_KVIDX_HEADER_BYTES + text_size + 1;
+    if (ftruncate(fd, (off_t)text_end) != 0)
+    {
+        return 0;
+    }
+
+    unsigned char *map = mmap(NULL, text_end, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        return 0;
+    }
+
+    /* Source text. Null terminated by the zero filled extension of the file */
+    char *text = (char *)map + KV_PARSE_KVIDX_HEADER_BYTES;
+    size_t got = 0;
+    while (got < text_size)
+    {
+        ssize_t n = read(source_fd, text + got, text_size - got);
+        if (n <= 0)
+        {
+            /* Error, or the source shrank while being read */
+            munmap(map, text_end);
+            return 0;
+        }
+        got += (size_t)n;
+    }
+
+    unsigned char header[KV_PARSE_KVIDX_HEADER_BYTES];
+    kv_parse_kvidx_header(header, source, kv_parse_kvidx_hash((const unsigned char *)text, text_size));
+
+    size_t image_max = kv_parse_kvc_compile(text, NULL, 0);
+    munmap(map, text_end);
+    if (image_max == 0 || ftruncate(fd, (off_t)(text_end + image_max)) != 0)
+    {
+        return 0;
+    }
+
+    map = mmap(NULL, text_end + image_max, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        return 0;
+    }
+
+    text = (char *)map + KV_PARSE_KVIDX_HEADER_BYTES;
+    size_t image_size = kv_parse_kvc_compile(text, map + text_end, image_max);
+    if (image_size > 0)
+    {
+        memmove(map + KV_PARSE_KVIDX_HEADER_BYTES, map + text_end, image_size);
+        memcpy(map, header, KV_PARSE_KVIDX_HEADER_BYTES);
+    }
+    munmap(map, text_end + image_max);
+
+    size_t size = KV_PARSE_KVIDX_HEADER_BYTES + image_size;
+    if (image_size == 0 || ftruncate(fd, (off_t)size) != 0)
+    {
+        return 0;
+    }
+    return size;
+}
+
+bool kv_parse_kvidx_build(const char *path)
+{
+    char sidecar[KV_PARSE_KVIDX_PATH_MAX];
+    char temp[KV_PARSE_KVIDX_PATH_MAX];
+    struct stat source;
+
+    if (!kv_parse_kvidx_path(sidecar, path, KV_PARSE_KVIDX_SUFFIX) || !kv_parse_kvidx_path(temp, sidecar, ".XXXXXX"))
+    {
+        return false;
+    }
+
+    int source_fd = open(path, O_RDONLY);
+    if (source_fd < 0)
+    {
+        return false;
+    }
+
+    if (fstat(source_fd, &source) != 0 || !S_ISREG(source.st_mode))
+    {
+        close(source_fd);
+        return false;
+    }
+
+    /* Temporary file in the same directory so the rename is atomic */
+    int fd = mkstemp(temp);
+    if (fd < 0)
+    {
+        close(source_fd);
+        return false;
+    }
+
+    bool built = kv_parse_kvidx_compile(fd, source_fd, &source) > 0;
+    close(source_fd);
+    built = built && fchmod(fd, source.st_mode & 0666) == 0;
+    built = close(fd) == 0 && built;
+    built = built && rename(temp, sidecar) == 0;
+    if (!built)
+    {
+        unlink(temp);
+    }
+    return built;
+}
+
+bool kv_parse_kvidx_open(kv_parse_kvc *kvc, const char *path)
+{
+    if (kv_parse_kvidx_load(kvc, path))
+    {
+        return true;
+    }
+
+    /* Missing or stale. Rebuild and map the result */
+    return kv_parse_kvidx_build(path) && kv_parse_kvidx_load(kvc, path);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file kv_parse_kvidx.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a persistent sidecar cache for key value files. The compiled image of a text
+ * file (see kv_parse_kvc.h) is kept next to it as `<path>.kvidx`, together with the size, mtime and
+ * inode of the source and a hash of its content. Processes that find a matching sidecar map the
+ * prebuilt table and skip tokenizing. A missing or stale sidecar is rebuilt through a temporary file
+ * renamed over the old one, so concurrent readers always see a whole sidecar.
+ *
+ * Sidecar layout: a 64 byte header recording the source identity, followed by a compiled image.
+ *
+ * Requires POSIX `mmap()`, `mkstemp()` and `rename()`.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * kv_parse_kvc kvc;
+ * if (kv_parse_kvidx_open(&kvc, "settings.env"))
+ * {
+ *     size_t value_len = kv_parse_kvc_get(&kvc, key, value, value_max);
+ *     kv_parse_kvc_close(&kvc);
+ * }
+ * @endcode
+ */
+#ifndef KV_PARSE_KVIDX_H
+#define KV_PARSE_KVIDX_H
+
+#include "kv_parse_kvc.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Appended to the source path to name its sidecar */
+#define KV_PARSE_KVIDX_SUFFIX ".kvidx"
+
+/* Sidecar format version */
+#define KV_PARSE_KVIDX_VERSION 2
+
+/* Bytes of the sidecar header before the compiled image */
+#define KV_PARSE_KVIDX_HEADER_BYTES 64
+
+/* Longest sidecar path, including the suffix and the temporary file name */
+#ifndef KV_PARSE_KVIDX_PATH_MAX
+#define KV_PARSE_KVIDX_PATH_MAX 4096
+#endif
+
+/**
+ * @brief Maps the sidecar of a key value file if it matches the file.
+ *
+ * The sidecar matches when it records the current size, mtime and inode of the source and was built
+ * with the same parser options (`KV_PARSE_DISABLE_*` and delimiters added to the byte classes).
+ * If the source was modified in the same second the sidecar was written, a later write could keep
+ * the same mtime, so the content hash is also checked by reading the source.
+ *
+ * @param kvc Reader to bind to the image in the sidecar. Close with `kv_parse_kvc_close()`.
+ * @param path Path of the key value text file.
+ *
+ * @return true if a matching sidecar was mapped, false if it is missing, stale or malformed.
+ */
+bool kv_parse_kvidx_load(kv_parse_kvc *kvc, const char *path);
+
+/**
+ * @brief Builds the sidecar of a key value file, replacing any previous one.
+ *
+ * The source is read once and compiled into a temporary file in the same directory, which is then
+ * renamed over the sidecar. The temporary file also serves as scratch space so no memory is allocated.
+ * The sidecar gets the read and write permissions of the source. If several processes rebuild at once,
+ * the last rename wins and every sidecar written is complete.
+ *
+ * @param path Path of the key value text file. Must be a regular file.
+ *
+ * @return true if the sidecar was written, false on any I/O error or if the source is too large for an image.
+ */
+bool kv_parse_kvidx_build(const char *path);
+
+/**
+ * @brief Maps the sidecar of a key value file, rebuilding it first if it is missing or stale.
+ *
+ * @param kvc Reader to bind to the image in the sidecar. Close with `kv_parse_kvc_close()`.
+ * @param path Path of the key value text file.
+ *
+ * @return true if a matching sidecar was mapped. false if it could not be built (e.g. the directory
+ *         is read only), in which case read the source with the text parsers instead.
+ */
+bool kv_parse_kvidx_open(kv_parse_kvc *kvc, const char *path);
+
+#endif
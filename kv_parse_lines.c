@@ -0,0 +1,257 @@
+/**
+ * @file kv_parse_lines.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a line offset table for the FILE parser. Offsets are appended as varint
+ * encoded distances while lines are walked and decoded forward from a cursor when lines are revisited.
+ * Key tags are stored one byte per line from the other end of the same storage.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#include "kv_parse_lines.h"
+#include "kv_parse.h"
+#include "kv_parse_class.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Longest varint of an unsigned long distance */
+#define KV_PARSE_LINES_VARINT_MAX ((sizeof(unsigned long) * 8 + 6) / 7)
+
+/* Appends the offset of the next checkpoint. Returns false once the storage is full */
+static bool kv_parse_lines_put(kv_parse_lines *lines, long offset)
+{
+    unsigned char varint[KV_PARSE_LINES_VARINT_MAX];
+    unsigned long distance = (unsigned long)(offset - lines->end);
+    size_t len = 0;
+
+    /* 7 bits per byte, high bit set on all but the last */
+    while (distance >= 0x80)
+    {
+        varint[len++] = (unsigned char)(distance | 0x80);
+        distance >>= 7;
+    }
+    varint[len++] = (unsigned char)distance;
+
+    if (len > lines->storage_size - lines->used - lines->tagged)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < len; i++)
+    {
+        lines->storage[lines->used++] = varint[i];
+    }
+    lines->count++;
+    lines->end = offset;
+    return true;
+}
+
+/* Offset of a recorded checkpoint. Decodes forward from the cursor, or from the start when going back */
+static long kv_parse_lines_offset(kv_parse_lines *lines, size_t checkpoint)
+{
+    if (checkpoint < lines->cursor)
+    {
+        lines->cursor = 0;
+        lines->cursor_used = 0;
+        lines->cursor_offset = 0;
+    }
+
+    while (lines->cursor < checkpoint)
+    {
+        unsigned long distance = 0;
+        unsigned int shift = 0;
+        unsigned char byte;
+        do
+        {
+            byte = lines->storage[lines->cursor_used++];
+            distance |= (unsigned long)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        lines->cursor_offset += (long)distance;
+        lines->cursor++;
+    }
+
+    return lines->cursor_offset;
+}
+
+/* Key tags hash the key up to the first whitespace, delimiter or line end. A line that matches a key
+ * has the same bytes up to there, so it always has the key's tag */
+#define KV_PARSE_LINES_TAG_END (KV_PARSE_CLASS_SPACE | KV_PARSE_CLASS_DELIMITER | KV_PARSE_CLASS_EOL | KV_PARSE_CLASS_NUL | KV_PARSE_CLASS_EOF)
+
+static uint32_t kv_parse_lines_tag_step(uint32_t hash, int ch)
+{
+    /* FNV-1a, one byte at a time as the key is read */
+    return (hash ^ (unsigned char)ch) * 16777619u;
+}
+
+static unsigned char kv_parse_lines_tag_final(uint32_t hash)
+{
+    return (unsigned char)(hash ^ (hash >> 8) ^ (hash >> 16) ^ (hash >> 24));
+}
+
+static unsigned char kv_parse_lines_key_tag(const char *key)
+{
+    uint32_t hash = 2166136261u;
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (KV_PARSE_IS(*key, KV_PARSE_CLASS_SPACE))
+    {
+        key++;
+    }
+#endif
+
+    for (; !KV_PARSE_IS(*key, KV_PARSE_LINES_TAG_END); key++)
+    {
+        hash = kv_parse_lines_tag_step(hash, *key);
+    }
+    return kv_parse_lines_tag_final(hash);
+}
+
+/* Tag of the key on the current line. The stream is returned to the start of the line */
+static unsigned char kv_parse_lines_read_tag(FILE *file)
+{
+    uint32_t hash = 2166136261u;
+    long start_of_line = ftell(file);
+    int ch = getc(file);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (KV_PARSE_IS_CH(ch, KV_PARSE_CLASS_SPACE))
+    {
+        ch = getc(file);
+    }
+#endif
+
+    for (; !KV_PARSE_IS_CH(ch, KV_PARSE_LINES_TAG_END); ch = getc(file))
+    {
+        hash = kv_parse_lines_tag_step(hash, ch);
+    }
+
+    fseek(file, start_of_line, SEEK_SET);
+    return kv_parse_lines_tag_final(hash);
+}
+
+void kv_parse_lines_init(kv_parse_lines *lines, unsigned char *storage, size_t storage_size, size_t stride)
+{
+    lines->storage = storage;
+    lines->storage_size = storage_size;
+    lines->used = 0;
+    lines->stride = stride == 0 ? 1 : stride;
+    lines->count = 1;
+    lines->end = 0;
+    lines->complete = false;
+    lines->total = 0;
+    lines->cursor = 0;
+    lines->cursor_used = 0;
+    lines->cursor_offset = 0;
+    lines->tagged = 0;
+}
+
+bool kv_parse_lines_next_line(kv_parse_lines *lines, FILE *file, size_t line_count)
+{
+    /* Check if first line */
+    if (line_count == 0)
+    {
+        /* Already at next line */
+        return true;
+    }
+
+    if (lines->complete && line_count >= lines->total)
+    {
+        /* File Finished Reading */
+        return false;
+    }
+
+    /* Known line. Jump over the rest of the current line */
+    size_t checkpoint = line_count / lines->stride;
+    bool boundary = line_count % lines->stride == 0;
+    if (boundary && checkpoint < lines->count)
+    {
+        return fseek(file, kv_parse_lines_offset(lines, checkpoint), SEEK_SET) == 0;
+    }
+
+    /* Walk to the next line */
+    if (!kv_parse_next_line(file, line_count))
+    {
+        lines->complete = true;
+        lines->total = line_count;
+        return false;
+    }
+
+    if (boundary && checkpoint == lines->count)
+    {
+        kv_parse_lines_put(lines, ftell(file));
+    }
+    return true;
+}
+
+bool kv_parse_seek_line(kv_parse_lines *lines, FILE *file, size_t line)
+{
+    if (lines->complete && line >= lines->total)
+    {
+        return false;
+    }
+
+    /* Nearest recorded line at or before the target */
+    size_t checkpoint = line / lines->stride;
+    if (checkpoint >= lines->count)
+    {
+        checkpoint = lines->count - 1;
+    }
+
+    if (fseek(file, kv_parse_lines_offset(lines, checkpoint), SEEK_SET) != 0)
+    {
+        return false;
+    }
+
+    for (size_t next = checkpoint * lines->stride + 1; next <= line; next++)
+    {
+        if (!kv_parse_lines_next_line(lines, file, next))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t kv_parse_lines_get(kv_parse_lines *lines, FILE *file, const char *key, char *value, size_t value_max)
+{
+    unsigned char tag = kv_parse_lines_key_tag(key);
+    bool walking = false;
+
+    for (size_t line = 0;; line++)
+    {
+        if (line < lines->tagged && lines->storage[lines->storage_size - 1 - line] != tag)
+        {
+            /* Key on this line differs. Skip it without reading */
+            walking = false;
+            continue;
+        }
+
+        /* Walk on from the previous line, or seek when lines were skipped */
+        if (walking ? !kv_parse_lines_next_line(lines, file, line) : !kv_parse_seek_line(lines, file, line))
+        {
+            return 0;
+        }
+        walking = true;
+
+        /* Tag the line the first time it is read, while there is room next to the offsets */
+        if (line == lines->tagged && lines->stride == 1 && line < lines->count && lines->used + lines->tagged < lines->storage_size)
+        {
+            lines->storage[lines->storage_size - 1 - line] = kv_parse_lines_read_tag(file);
+            lines->tagged++;
+            if (lines->storage[lines->storage_size - 1 - line] != tag)
+            {
+                continue;
+            }
+        }
+
+        if (kv_parse_check_key(file, key))
+        {
+            return kv_parse_get_value(file, value, value_max);
+        }
+    }
+}
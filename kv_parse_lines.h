@@ -0,0 +1,121 @@
+/**
+ * @file kv_parse_lines.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a line offset table for the FILE parser. Line offsets are recorded as a side
+ * effect of walking the file with `kv_parse_lines_next_line()`, so once a line has been seen later
+ * scans jump to it with one `fseek()` instead of reading the rest of the previous line a byte at a time.
+ *
+ * An offset is kept for every `stride` lines (every line with a stride of 1). Offsets are stored as
+ * the varint encoded distance from the previous checkpoint in caller supplied storage, which is about
+ * one byte per checkpoint while `stride` lines span less than 128 bytes. Once the storage is full
+ * later lines are walked as usual.
+ *
+ * With a stride of 1, `kv_parse_lines_get()` also keeps a one byte hash of the key of each line it
+ * reads, taken from the other end of the storage. Later lookups only seek to lines whose tag matches,
+ * about 1 in 256 of the lines that hold other keys.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * static unsigned char storage[4096];
+ * kv_parse_lines lines;
+ * kv_parse_lines_init(&lines, storage, sizeof(storage), 1);
+ *
+ * return kv_parse_lines_get(&lines, file, key, value, value_max);
+ * @endcode
+ */
+#ifndef KV_PARSE_LINES_H
+#define KV_PARSE_LINES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief Offsets of lines seen so far in one file.
+ *
+ * Checkpoint k is the offset of line `k * stride`. Checkpoint 0 is the start of the file.
+ * Offsets are only valid while the file is unchanged. Call `kv_parse_lines_init()` again after it changes.
+ */
+typedef struct kv_parse_lines
+{
+    unsigned char *storage;
+    size_t storage_size;
+    size_t used;   /* Bytes of encoded distances */
+    size_t stride; /* Lines between checkpoints */
+    size_t count;  /* Checkpoints recorded */
+    long end;      /* Offset of the last checkpoint */
+
+    /* Known once the end of the file was reached */
+    bool complete;
+    size_t total; /* Lines in the file */
+
+    /* Last decoded checkpoint, so scans decode each distance once */
+    size_t cursor;
+    size_t cursor_used;
+    long cursor_offset;
+
+    /* Lines with a key tag. Tag of line k is at storage[storage_size - 1 - k] */
+    size_t tagged;
+} kv_parse_lines;
+
+/**
+ * @brief Binds a line offset table to caller supplied storage.
+ *
+ * @param lines Table to initialise.
+ * @param storage Storage for the encoded offsets.
+ * @param storage_size Size of the storage in bytes.
+ * @param stride Lines between recorded offsets. 1 records every line and its key tag, larger values bound
+ *               memory for huge files.
+ */
+void kv_parse_lines_init(kv_parse_lines *lines, unsigned char *storage, size_t storage_size, size_t stride);
+
+/**
+ * @brief Advances the file stream to the next line, recording or using its offset.
+ *
+ * Same as `kv_parse_next_line()`, except that a line with a recorded offset is reached with `fseek()`
+ * and a line count past the known end of the file returns false without reading.
+ *
+ * @param lines Table for this file.
+ * @param file Pointer to the file stream.
+ * @param line_count The current line number (0-based). If line_count is 0, the stream is left where it is.
+ *
+ * @return true if the function successfully moves to the next line, false if EOF is reached.
+ */
+bool kv_parse_lines_next_line(kv_parse_lines *lines, FILE *file, size_t line_count);
+
+/**
+ * @brief Moves the file stream to the start of a line.
+ *
+ * Seeks to the nearest recorded line at or before `line` and walks the remaining lines, recording their
+ * offsets. With a stride of 1 a line seen before is reached with a single `fseek()`.
+ *
+ * @param lines Table for this file.
+ * @param file Pointer to the file stream.
+ * @param line Line number (0-based).
+ *
+ * @return true if the stream is at the start of the line, false if the file has fewer lines.
+ */
+bool kv_parse_seek_line(kv_parse_lines *lines, FILE *file, size_t line);
+
+/**
+ * @brief Retrieves the value of a key, seeking only to lines that may hold it.
+ *
+ * Same result as walking every line with `kv_parse_check_key()` from the start of the file. Lines with
+ * a recorded key tag that differs from the key are skipped without reading. Other lines are read as
+ * usual, recording their offsets and tags.
+ *
+ * @param lines Table for this file.
+ * @param file Pointer to the file stream.
+ * @param key The key to look up.
+ * @param value Buffer for the value.
+ * @param value_max Size of the value buffer.
+ *
+ * @return The length of the value, or 0 if the key was not found.
+ */
+size_t kv_parse_lines_get(kv_parse_lines *lines, FILE *file, const char *key, char *value, size_t value_max);
+
+#endif
@@ -0,0 +1,300 @@
+/**
+ * @file kv_parse_live.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a hot reloading store for a key value file. Snapshots are built by the owner
+ * thread and published with an atomic pointer swap. Readers announce the epoch they entered in,
+ * and a replaced snapshot is freed once no reader announces an epoch from before the swap.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS */
+#endif
+
+#include "kv_parse_live.h"
+#include "kv_parse_index.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Directory events that may change the file. Creating a file is followed by a close after writing */
+#define KV_PARSE_LIVE_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO | IN_ATTRIB)
+
+static void *kv_parse_live_alloc(size_t size)
+{
+    void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+static void kv_parse_live_free(kv_parse_live_snapshot *snapshot)
+{
+    if (snapshot->storage != NULL)
+    {
+        munmap(snapshot->storage, snapshot->storage_size);
+    }
+    munmap(snapshot->map, snapshot->map_size);
+}
+
+static bool kv_parse_live_changed(const kv_parse_live_snapshot *snapshot, const struct stat *st)
+{
+    return snapshot->size != (uint64_t)st->st_size || snapshot->mtime != (uint64_t)st->st_mtime || snapshot->mtime_nsec != (uint64_t)st->st_mtim.tv_nsec ||
+           snapshot->inode != (uint64_t)st->st_ino;
+}
+
+/* Reads the file and indexes it into a new snapshot. Returns NULL if the file could not be read */
+static kv_parse_live_snapshot *kv_parse_live_load(const char *path)
+{
+    struct stat st;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    /* Snapshot followed by the null terminated text */
+    size_t text_size = (size_t)st.st_size;
+    size_t map_size = sizeof(kv_parse_live_snapshot) + text_size + 1;
+    kv_parse_live_snapshot *snapshot = kv_parse_live_alloc(map_size);
+    if (snapshot == NULL)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    snapshot->map = snapshot;
+    snapshot->map_size = map_size;
+    snapshot->storage = NULL;
+    snapshot->buffer = (char *)(snapshot + 1);
+    snapshot->size = (uint64_t)st.st_size;
+    snapshot->mtime = (uint64_t)st.st_mtime;
+    snapshot->mtime_nsec = (uint64_t)st.st_mtim.tv_nsec;
+    snapshot->inode = (uint64_t)st.st_ino;
+    snapshot->next = NULL;
+
+    /* Text as of now. A file truncated while being read is kept as far as it was read */
+    size_t got = 0;
+    while (got < text_size)
+    {
+        ssize_t n = read(fd, snapshot->buffer + got, text_size - got);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            break;
+        }
+        got += (size_t)n;
+    }
+    close(fd);
+    snapshot->buffer[got] = '\0';
+
+    /* Every record ends a line, so lines bound the index capacity */
+    size_t capacity = 1;
+    for (const char *line = snapshot->buffer; (line = memchr(line, '\n', got - (size_t)(line - snapshot->buffer))) != NULL; line++)
+    {
+        capacity++;
+    }
+
+    snapshot->storage_size = KV_PARSE_INDEX_BYTES(capacity);
+    snapshot->storage = kv_parse_live_alloc(snapshot->storage_size);
+    if (snapshot->storage == NULL)
+    {
+        kv_parse_live_free(snapshot);
+        return NULL;
+    }
+
+    kv_parse_index_init(&snapshot->index, snapshot->storage, capacity);
+    kv_parse_buffer_index(&snapshot->index, snapshot->buffer);
+    return snapshot;
+}
+
+/* Frees retired snapshots that no reader can still be using */
+static void kv_parse_live_reclaim(kv_parse_live *live)
+{
+    /* Oldest epoch a reader is in. Readers in later epochs entered after the swaps that retired older snapshots */
+    uint64_t oldest = UINT64_MAX;
+    for (size_t i = 0; i < KV_PARSE_LIVE_READERS; i++)
+    {
+        uint64_t epoch = __atomic_load_n(&live->reader[i].epoch, __ATOMIC_SEQ_CST);
+        if (epoch != 0 && epoch < oldest)
+        {
+            oldest = epoch;
+        }
+    }
+
+    kv_parse_live_snapshot **link = &live->retired;
+    while (*link != NULL)
+    {
+        kv_parse_live_snapshot *snapshot = *link;
+        if (snapshot->retired_epoch < oldest)
+        {
+            *link = snapshot->next;
+            kv_parse_live_free(snapshot);
+        }
+        else
+        {
+            link = &snapshot->next;
+        }
+    }
+}
+
+static void kv_parse_live_publish(kv_parse_live *live, kv_parse_live_snapshot *snapshot)
+{
+    snapshot->generation = live->generation++;
+
+    kv_parse_live_snapshot *old = __atomic_exchange_n(&live->current, snapshot, __ATOMIC_SEQ_CST);
+    if (old != NULL)
+    {
+        /* Readers that entered in this epoch or before may still hold the old snapshot */
+        old->retired_epoch = __atomic_load_n(&live->epoch, __ATOMIC_SEQ_CST);
+        old->next = live->retired;
+        live->retired = old;
+        __atomic_store_n(&live->epoch, old->retired_epoch + 1, __ATOMIC_SEQ_CST);
+    }
+
+    kv_parse_live_reclaim(live);
+}
+
+bool kv_parse_live_open(kv_parse_live *live, const char *path)
+{
+    size_t path_len = strlen(path);
+
+    memset(live, 0, sizeof(*live));
+    live->fd = -1;
+    live->watch = -1;
+    live->epoch = 1;
+    if (path_len >= KV_PARSE_LIVE_PATH_MAX)
+    {
+        return false;
+    }
+    memcpy(live->path, path, path_len + 1);
+
+    /* Watch the directory rather than the file, which may be replaced */
+    char dir[KV_PARSE_LIVE_PATH_MAX];
+    const char *slash = strrchr(path, '/');
+    if (slash == NULL)
+    {
+        memcpy(dir, ".", 2);
+    }
+    else
+    {
+        size_t dir_len = slash == path ? 1 : (size_t)(slash - path);
+        memcpy(dir, path, dir_len);
+        dir[dir_len] = '\0';
+    }
+
+    live->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (live->fd < 0)
+    {
+        return false;
+    }
+
+    live->watch = inotify_add_watch(live->fd, dir, KV_PARSE_LIVE_EVENTS);
+    if (live->watch < 0 || !kv_parse_live_reload(live))
+    {
+        kv_parse_live_close(live);
+        return false;
+    }
+    return true;
+}
+
+void kv_parse_live_close(kv_parse_live *live)
+{
+    if (live->fd >= 0)
+    {
+        close(live->fd);
+    }
+
+    if (live->current != NULL)
+    {
+        kv_parse_live_free(live->current);
+    }
+
+    while (live->retired != NULL)
+    {
+        kv_parse_live_snapshot *snapshot = live->retired;
+        live->retired = snapshot->next;
+        kv_parse_live_free(snapshot);
+    }
+
+    live->fd = -1;
+    live->watch = -1;
+    live->current = NULL;
+}
+
+bool kv_parse_live_reload(kv_parse_live *live)
+{
+    kv_parse_live_snapshot *snapshot = kv_parse_live_load(live->path);
+    if (snapshot == NULL)
+    {
+        return false;
+    }
+
+    kv_parse_live_publish(live, snapshot);
+    return true;
+}
+
+bool kv_parse_live_poll(kv_parse_live *live, int timeout_ms)
+{
+    struct pollfd pfd = {live->fd, POLLIN, 0};
+    bool event = poll(&pfd, 1, timeout_ms) > 0;
+
+    if (event)
+    {
+        /* Drain the events. Any of them may be the file, including a symlink swap of a parent entry */
+        char events[4096];
+        while (read(live->fd, events, sizeof(events)) > 0)
+        {
+        }
+    }
+
+    struct stat st;
+    bool reloaded = false;
+    if (event && stat(live->path, &st) == 0 && kv_parse_live_changed(live->current, &st))
+    {
+        reloaded = kv_parse_live_reload(live);
+    }
+
+    /* Readers may have left snapshots retired by earlier reloads */
+    kv_parse_live_reclaim(live);
+    return reloaded;
+}
+
+const kv_parse_live_snapshot *kv_parse_live_enter(kv_parse_live *live, size_t reader)
+{
+    /* Announce the epoch before loading the pointer. A swap after this point cannot free what is loaded */
+    uint64_t epoch = __atomic_load_n(&live->epoch, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&live->reader[reader].epoch, epoch, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&live->current, __ATOMIC_SEQ_CST);
+}
+
+void kv_parse_live_exit(kv_parse_live *live, size_t reader)
+{
+    __atomic_store_n(&live->reader[reader].epoch, 0, __ATOMIC_RELEASE);
+}
+
+size_t kv_parse_live_get(kv_parse_live *live, size_t reader, const char *key, char *value, size_t value_max)
+{
+    const kv_parse_live_snapshot *snapshot = kv_parse_live_enter(live, reader);
+    size_t value_len = kv_parse_index_get(&snapshot->index, key, value, value_max);
+    kv_parse_live_exit(live, reader);
+    return value_len;
+}
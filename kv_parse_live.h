@@ -0,0 +1,183 @@
+/**
+ * @file kv_parse_live.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a hot reloading store for a key value file. The file is watched with inotify
+ * and each change is loaded into a fresh immutable snapshot (a copy of the text and an index built
+ * over it) off the request path. Snapshots are published with an atomic pointer swap, so readers
+ * never take a lock, and a replaced snapshot is freed only once every reader has left it (epoch
+ * based reclamation).
+ *
+ * One thread owns the store and calls `kv_parse_live_poll()` or `kv_parse_live_reload()`. Any number
+ * of reader threads, each with its own reader slot, look up keys concurrently.
+ *
+ * Requires Linux `inotify` and the GCC/Clang `__atomic` builtins.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * static kv_parse_live live;
+ * kv_parse_live_open(&live, "settings.env");
+ *
+ * // Owner thread
+ * while (running)
+ * {
+ *     kv_parse_live_poll(&live, 1000);
+ * }
+ *
+ * // Reader thread `reader`
+ * size_t value_len = kv_parse_live_get(&live, reader, key, value, value_max);
+ * @endcode
+ */
+#ifndef KV_PARSE_LIVE_H
+#define KV_PARSE_LIVE_H
+
+#include "kv_parse_index.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Reader slots, one per concurrent reader thread */
+#ifndef KV_PARSE_LIVE_READERS
+#define KV_PARSE_LIVE_READERS 64
+#endif
+
+/* Longest watched path */
+#ifndef KV_PARSE_LIVE_PATH_MAX
+#define KV_PARSE_LIVE_PATH_MAX 4096
+#endif
+
+/**
+ * @brief Immutable contents of the file at one point in time.
+ *
+ * The text and the index storage live in memory owned by the snapshot.
+ */
+typedef struct kv_parse_live_snapshot
+{
+    kv_parse_index index; /* Index over `buffer` */
+    char *buffer;         /* Null terminated copy of the file */
+    size_t generation;    /* 0 for the first load, incremented on every reload */
+
+    /* File identity the snapshot was loaded from */
+    uint64_t size;
+    uint64_t mtime;
+    uint64_t mtime_nsec;
+    uint64_t inode;
+
+    /* Memory of the snapshot and of the index storage */
+    void *map;
+    size_t map_size;
+    void *storage;
+    size_t storage_size;
+
+    /* Reclamation */
+    uint64_t retired_epoch;
+    struct kv_parse_live_snapshot *next;
+} kv_parse_live_snapshot;
+
+/**
+ * @brief Epoch announced by one reader, 0 outside a read. Padded to a cache line so readers do not share lines.
+ */
+typedef struct kv_parse_live_reader
+{
+    uint64_t epoch;
+    unsigned char pad[64 - sizeof(uint64_t)];
+} kv_parse_live_reader;
+
+/**
+ * @brief Hot reloading store. Initialise with `kv_parse_live_open()`.
+ */
+typedef struct kv_parse_live
+{
+    char path[KV_PARSE_LIVE_PATH_MAX];
+    int fd;    /* inotify descriptor, readable when the directory of the file changed. See `kv_parse_live_poll()` */
+    int watch; /* Watch on the directory, so files replaced by rename are seen */
+
+    kv_parse_live_snapshot *current; /* Published snapshot, swapped atomically */
+    uint64_t epoch;                  /* Global epoch, advanced on every publish */
+    kv_parse_live_reader reader[KV_PARSE_LIVE_READERS];
+
+    kv_parse_live_snapshot *retired; /* Replaced snapshots waiting for readers to leave */
+    size_t generation;
+} kv_parse_live;
+
+/**
+ * @brief Loads a key value file and starts watching it.
+ *
+ * @param live Store to initialise.
+ * @param path Path of the file. Its directory is watched, so the file may be rewritten in place or
+ *             replaced with `rename()` (including a symlink swap).
+ *
+ * @return true if the file was loaded and the watch set up, false otherwise.
+ */
+bool kv_parse_live_open(kv_parse_live *live, const char *path);
+
+/**
+ * @brief Stops watching and frees every snapshot.
+ *
+ * @param live Store opened with `kv_parse_live_open()`. No reader may be inside the store.
+ */
+void kv_parse_live_close(kv_parse_live *live);
+
+/**
+ * @brief Waits for changes to the file and reloads it. Called by the owner thread only.
+ *
+ * Events on the directory are drained and the file is reloaded if its size, mtime or inode changed.
+ * Snapshots that no reader is using any more are freed.
+ *
+ * @param live Store opened with `kv_parse_live_open()`.
+ * @param timeout_ms Longest time to wait for an event in milliseconds, 0 to only check, -1 to wait forever.
+ *
+ * @return true if a new snapshot was published.
+ */
+bool kv_parse_live_poll(kv_parse_live *live, int timeout_ms);
+
+/**
+ * @brief Loads the file into a new snapshot and publishes it, whether it changed or not. Called by the owner thread only.
+ *
+ * @param live Store opened with `kv_parse_live_open()`.
+ *
+ * @return true if a new snapshot was published. false if the file could not be read, in which case
+ *         readers keep the previous snapshot.
+ */
+bool kv_parse_live_reload(kv_parse_live *live);
+
+/**
+ * @brief Enters a read and returns the current snapshot. Wait free.
+ *
+ * The snapshot stays valid, and unchanged, until `kv_parse_live_exit()` with the same reader.
+ * Several lookups between enter and exit see the same version of the file.
+ *
+ * @param live Store opened with `kv_parse_live_open()`.
+ * @param reader Reader slot of the calling thread, below KV_PARSE_LIVE_READERS. One thread per slot.
+ *
+ * @return The current snapshot.
+ */
+const kv_parse_live_snapshot *kv_parse_live_enter(kv_parse_live *live, size_t reader);
+
+/**
+ * @brief Leaves a read started with `kv_parse_live_enter()`. Wait free.
+ *
+ * @param live Store opened with `kv_parse_live_open()`.
+ * @param reader Reader slot passed to `kv_parse_live_enter()`.
+ */
+void kv_parse_live_exit(kv_parse_live *live, size_t reader);
+
+/**
+ * @brief Extracts the value associated with a key from the current snapshot. Wait free.
+ *
+ * Same as `kv_parse_live_enter()`, `kv_parse_index_get()` and `kv_parse_live_exit()`.
+ *
+ * @param live Store opened with `kv_parse_live_open()`.
+ * @param reader Reader slot of the calling thread, below KV_PARSE_LIVE_READERS.
+ * @param key The key to search for.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the key is missing, the value is too large or empty.
+ */
+size_t kv_parse_live_get(kv_parse_live *live, size_t reader, const char *key, char *value, size_t value_max);
+
+#endif
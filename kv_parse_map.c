@@ -0,0 +1,155 @@
+/**
+ * @file kv_parse_map.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a memory mapped file engine. Regular files are mapped read only and parsed
+ * in place with the span API of the buffer parser, so lookups walk pointers instead of calling
+ * `getc()`, `ftell()` and `fseek()`. Other files (pipes, character devices) cannot be mapped or
+ * rewound, so they are read once into anonymous memory and parsed the same way.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS */
+#endif
+
+#include "kv_parse_map.h"
+#include "kv_parse_buffer.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Reads a stream to its end into anonymous memory, doubling the mapping as it fills */
+static bool kv_parse_map_read(kv_parse_map *map, int fd)
+{
+    size_t map_size = 64 * 1024;
+    size_t used = 0;
+    char *data = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        if (used == map_size)
+        {
+            char *grown = mmap(NULL, map_size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (grown == MAP_FAILED)
+            {
+                munmap(data, map_size);
+                return false;
+            }
+            memcpy(grown, data, used);
+            munmap(data, map_size);
+            data = grown;
+            map_size *= 2;
+        }
+
+        ssize_t count = read(fd, data + used, map_size - used);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count < 0)
+        {
+            munmap(data, map_size);
+            return false;
+        }
+        if (count == 0)
+        {
+            break;
+        }
+        used += (size_t)count;
+    }
+
+    map->data = data;
+    map->size = used;
+    map->map_size = map_size;
+    return true;
+}
+
+bool kv_parse_map_open(kv_parse_map *map, const char *path)
+{
+    struct stat st;
+
+    map->data = NULL;
+    map->size = 0;
+    map->map_size = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        /* Not a regular file. Read it once from the same descriptor, so no data is lost and every lookup sees all of it */
+        bool read_all = kv_parse_map_read(map, fd);
+        close(fd);
+        return read_all;
+    }
+
+    if (st.st_size == 0)
+    {
+        /* Nothing to map */
+        close(fd);
+        map->data = "";
+        return true;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    /* Lookups scan the file front to back */
+    posix_madvise(data, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+
+    map->data = (const char *)data;
+    map->size = (size_t)st.st_size;
+    map->map_size = (size_t)st.st_size;
+    return true;
+}
+
+size_t kv_parse_map_get(kv_parse_map *map, const char *key, char *value, size_t value_max)
+{
+    const char *str = map->data;
+    const char *end = map->data + map->size;
+    for (size_t line = 0; (str = kv_parse_span_next_line(str, end, line)) != NULL; line++)
+    {
+        const char *str_value = NULL;
+        if ((str_value = kv_parse_span_check_key(str, end, key)) != NULL)
+        {
+            return kv_parse_span_get_value(str_value, end, value, value_max);
+        }
+    }
+
+    /* Key not found */
+    value[0] = '\0';
+    return 0;
+}
+
+void kv_parse_map_close(kv_parse_map *map)
+{
+    if (map->map_size > 0)
+    {
+        munmap((void *)map->data, map->map_size);
+    }
+
+    map->data = NULL;
+    map->size = 0;
+    map->map_size = 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file kv_parse_map.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a memory mapped file engine. Regular files are mapped read only and parsed
+ * in place with the span API of the buffer parser, so lookups walk pointers instead of calling
+ * `getc()`, `ftell()` and `fseek()`. Other files (pipes, character devices) cannot be mapped or
+ * rewound, so they are read once into anonymous memory and parsed the same way.
+ *
+ * Requires POSIX `mmap()`.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * kv_parse_map map;
+ * if (kv_parse_map_open(&map, "settings.env"))
+ * {
+ *     size_t value_len = kv_parse_map_get(&map, key, value, value_max);
+ *     kv_parse_map_close(&map);
+ * }
+ * @endcode
+ */
+#ifndef KV_PARSE_MAP_H
+#define KV_PARSE_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Opened key value file.
+ *
+ * The whole file is at `data` and can also be passed directly to the `kv_parse_span_*()` functions.
+ */
+typedef struct kv_parse_map
+{
+    const char *data;
+    size_t size;
+    size_t map_size; /* Bytes mapped at `data`. 0 for an empty regular file */
+} kv_parse_map;
+
+/**
+ * @brief Opens a key value file, mapping it into memory when possible.
+ *
+ * Regular files are mapped read only and advised for sequential access. Anything else is
+ * read to its end from the descriptor that was checked, into anonymous memory, so the path
+ * is opened once, data already in a pipe is kept and every lookup sees the whole stream.
+ *
+ * @param map Map to initialise.
+ * @param path Path of the file to open.
+ *
+ * @return true if the file was opened, false otherwise.
+ */
+bool kv_parse_map_open(kv_parse_map *map, const char *path);
+
+/**
+ * @brief Extracts the value associated with a key from an opened file.
+ *
+ * @param map Map opened with `kv_parse_map_open()`.
+ * @param key The key to search for.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the key is missing, the value is too large or empty.
+ *         A missing key leaves `value` empty.
+ */
+size_t kv_parse_map_get(kv_parse_map *map, const char *key, char *value, size_t value_max);
+
+/**
+ * @brief Unmaps or closes a file opened with `kv_parse_map_open()`.
+ *
+ * @param map Map to close.
+ */
+void kv_parse_map_close(kv_parse_map *map);
+
+#endif
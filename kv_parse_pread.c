@@ -0,0 +1,254 @@
+/**
+ * @file kv_parse_pread.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a positional file descriptor parser. Lines are read with `pread()` into a
+ * block held by the cursor (or on the stack for `kv_parse_pread_get()`) and parsed in place with the
+ * span API of the buffer parser.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "kv_parse_pread.h"
+#include "kv_parse_buffer.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/* Reads up to `size` bytes at `offset`. Short only at the end of the file or on error */
+static size_t kv_parse_pread_block(int fd, char *block, size_t size, off_t offset)
+{
+    size_t got = 0;
+    while (got < size)
+    {
+        ssize_t n = pread(fd, block + got, size - got, offset + (off_t)got);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            break;
+        }
+        got += (size_t)n;
+    }
+    return got;
+}
+
+/* Bytes of the current line from the start, as held in the cursor block. At most KV_PARSE_PREAD_BLOCK */
+static const char *kv_parse_pread_cached_line(const kv_parse_cursor *cursor, size_t *count)
+{
+    size_t len = (size_t)(cursor->line_end - cursor->line);
+    *count = len < KV_PARSE_PREAD_BLOCK ? len : KV_PARSE_PREAD_BLOCK;
+    return cursor->block + (cursor->line - cursor->block_offset);
+}
+
+static void kv_parse_pread_fill_line(kv_parse_cursor *cursor)
+{
+    off_t offset = cursor->line;
+
+    cursor->pos = cursor->line;
+
+    /* Line usually starts and ends in the block read for an earlier line */
+    if (offset >= cursor->block_offset && offset < cursor->block_offset + (off_t)cursor->block_len)
+    {
+        size_t skip = (size_t)(offset - cursor->block_offset);
+        const char *newline = memchr(cursor->block + skip, '\n', cursor->block_len - skip);
+        if (newline != NULL)
+        {
+            cursor->line_end = cursor->block_offset + (off_t)(newline - cursor->block);
+            cursor->eof = false;
+            return;
+        }
+    }
+
+    /* Read a block from the start of the line, kept for the key, value and section checks */
+    size_t count = kv_parse_pread_block(cursor->fd, cursor->block, sizeof(cursor->block), offset);
+    cursor->block_offset = offset;
+    cursor->block_len = count;
+
+    const char *newline = memchr(cursor->block, '\n', count);
+    if (newline != NULL)
+    {
+        cursor->line_end = offset + (off_t)(newline - cursor->block);
+        cursor->eof = false;
+        return;
+    }
+
+    /* Line longer than the block. Find its end without replacing the block */
+    char block[KV_PARSE_PREAD_BLOCK];
+    while (count == sizeof(block))
+    {
+        offset += (off_t)count;
+        count = kv_parse_pread_block(cursor->fd, block, sizeof(block), offset);
+        newline = memchr(block, '\n', count);
+        if (newline != NULL)
+        {
+            cursor->line_end = offset + (off_t)(newline - block);
+            cursor->eof = false;
+            return;
+        }
+    }
+
+    /* Last line has no newline */
+    cursor->line_end = offset + (off_t)count;
+    cursor->eof = true;
+}
+
+void kv_parse_pread_init(kv_parse_cursor *cursor, int fd)
+{
+    cursor->fd = fd;
+    cursor->line = 0;
+    cursor->line_end = 0;
+    cursor->pos = 0;
+    cursor->eof = false;
+    cursor->block_offset = 0;
+    cursor->block_len = 0;
+}
+
+bool kv_parse_pread_next_line(kv_parse_cursor *cursor, size_t line_count)
+{
+    /* Check if first line */
+    if (line_count == 0)
+    {
+        /* Already at next line */
+        kv_parse_pread_fill_line(cursor);
+        return true;
+    }
+
+    if (cursor->eof)
+    {
+        /* File Finished Reading */
+        return false;
+    }
+
+    /* Advance to next line */
+    cursor->line = cursor->line_end + 1;
+    kv_parse_pread_fill_line(cursor);
+    return !(cursor->eof && cursor->line == cursor->line_end);
+}
+
+bool kv_parse_pread_check_key(kv_parse_cursor *cursor, const char *key)
+{
+    size_t count;
+    const char *line = kv_parse_pread_cached_line(cursor, &count);
+
+    const char *value = kv_parse_span_check_key(line, line + count, key);
+    if (value == NULL)
+    {
+        /* Key was not found. Backtrack to start of line */
+        cursor->pos = cursor->line;
+        return false;
+    }
+
+    /* Key Found. Next position is the value */
+    cursor->pos = cursor->line + (off_t)(value - line);
+    return true;
+}
+
+size_t kv_parse_pread_get_value(const kv_parse_cursor *cursor, char *value, size_t value_max)
+{
+    if (cursor->line_end - cursor->pos > KV_PARSE_PREAD_BLOCK)
+    {
+        /* Value continues past the block. Don't return a value. */
+        value[0] = '\0';
+        return 0;
+    }
+
+    if (cursor->pos >= cursor->block_offset && cursor->line_end <= cursor->block_offset + (off_t)cursor->block_len)
+    {
+        /* Value is in the block read for the line */
+        const char *str = cursor->block + (cursor->pos - cursor->block_offset);
+        return kv_parse_span_get_value(str, str + (cursor->line_end - cursor->pos), value, value_max);
+    }
+
+    /* Value at the end of a line longer than the block */
+    char block[KV_PARSE_PREAD_BLOCK];
+    size_t count = kv_parse_pread_block(cursor->fd, block, (size_t)(cursor->line_end - cursor->pos), cursor->pos);
+    return kv_parse_span_get_value(block, block + count, value, value_max);
+}
+
+size_t kv_parse_pread_check_section(const kv_parse_cursor *cursor, char *section, size_t section_max)
+{
+    size_t count;
+    const char *line = kv_parse_pread_cached_line(cursor, &count);
+    return kv_parse_span_check_section(line, line + count, section, section_max);
+}
+
+size_t kv_parse_pread_get(int fd, const char *key, char *value, size_t value_max)
+{
+    char block[KV_PARSE_PREAD_BLOCK];
+    off_t offset = 0;
+    bool skip = false;
+
+    value[0] = '\0';
+    for (;;)
+    {
+        size_t count = kv_parse_pread_block(fd, block, sizeof(block), offset);
+        const char *line = block;
+        const char *end = block + count;
+        bool last = count < sizeof(block);
+
+        if (skip)
+        {
+            /* Discard the rest of a line longer than the block */
+            const char *newline = memchr(block, '\n', count);
+            if (newline == NULL)
+            {
+                if (last)
+                {
+                    return 0;
+                }
+                offset += (off_t)count;
+                continue;
+            }
+            line = newline + 1;
+            skip = false;
+        }
+
+        /* Lines that end inside the block */
+        for (;;)
+        {
+            const char *newline = memchr(line, '\n', (size_t)(end - line));
+            if (newline == NULL && !last)
+            {
+                break;
+            }
+
+            const char *line_end = newline != NULL ? newline : end;
+            const char *str_value = kv_parse_span_check_key(line, line_end, key);
+            if (str_value != NULL)
+            {
+                return kv_parse_span_get_value(str_value, line_end, value, value_max);
+            }
+
+            if (newline == NULL)
+            {
+                /* Key not found */
+                return 0;
+            }
+            line = newline + 1;
+        }
+
+        if (line == block)
+        {
+            /* Line longer than the block. The key can still match, but the value does not fit */
+            if (kv_parse_span_check_key(block, end, key) != NULL)
+            {
+                return 0;
+            }
+            skip = true;
+            line = end;
+        }
+
+        /* Read on from the start of the unfinished line */
+        offset += (off_t)(line - block);
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file kv_parse_pread.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a positional file descriptor parser. Reads use `pread()` at an explicit offset,
+ * and all parser state lives in a caller owned cursor, including the block last read so that short
+ * lines that follow it are parsed without another read. The descriptor's file position is never used,
+ * so many threads can look up keys in one open file at the same time without locks or duplicated
+ * descriptors.
+ *
+ * Requires POSIX `pread()`.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * int fd = open("settings.env", O_RDONLY);
+ *
+ * // Any thread
+ * size_t value_len = kv_parse_pread_get(fd, key, value, value_max);
+ * @endcode
+ */
+#ifndef KV_PARSE_PREAD_H
+#define KV_PARSE_PREAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+/* Bytes read per `pread()`. Longer lines cannot return values or sections */
+#ifndef KV_PARSE_PREAD_BLOCK
+#define KV_PARSE_PREAD_BLOCK 4096
+#endif
+
+/**
+ * @brief Position of a parser in a file. Owned by one thread at a time.
+ *
+ * All positions are file offsets. The current line is `[line, line_end)`. The block holds the
+ * start of the current line, so checking a line reads nothing beyond what moving to it read.
+ */
+typedef struct kv_parse_cursor
+{
+    int fd;
+    off_t line;
+    off_t line_end; /* Offset of the '\n' ending the line, or the end of the file */
+    off_t pos;      /* Start of the value after a successful `kv_parse_pread_check_key()`, else `line` */
+    bool eof;       /* Line ends at the end of the file */
+
+    /* File bytes `[block_offset, block_offset + block_len)` */
+    off_t block_offset;
+    size_t block_len;
+    char block[KV_PARSE_PREAD_BLOCK];
+} kv_parse_cursor;
+
+/**
+ * @brief Starts a cursor at the beginning of a file.
+ *
+ * @param cursor Cursor to initialise.
+ * @param fd File descriptor open for reading. Must support `pread()` (regular files).
+ */
+void kv_parse_pread_init(kv_parse_cursor *cursor, int fd);
+
+/**
+ * @brief Advances the cursor to the next line.
+ *
+ * Same as `kv_parse_next_line()`. Reads only when the line does not end inside the cursor block,
+ * so a file of short lines costs one `pread()` per KV_PARSE_PREAD_BLOCK bytes.
+ *
+ * @param cursor Cursor initialised with `kv_parse_pread_init()`.
+ * @param line_count The current line number (0-based). If line_count is 0, the cursor stays on the first line.
+ *
+ * @return true if the cursor moved to the next line, false if the end of the file is reached.
+ */
+bool kv_parse_pread_next_line(kv_parse_cursor *cursor, size_t line_count);
+
+/**
+ * @brief Checks if the current line contains the specified key.
+ *
+ * Same as `kv_parse_check_key()`. On a match the cursor position moves to the value,
+ * otherwise it stays at the start of the line.
+ *
+ * @param cursor Cursor positioned on a line.
+ * @param key The key to search for.
+ *
+ * @return true if the key is found, false otherwise.
+ */
+bool kv_parse_pread_check_key(kv_parse_cursor *cursor, const char *key);
+
+/**
+ * @brief Extracts the value at the cursor position.
+ *
+ * Same as `kv_parse_get_value()`. The cursor is left unchanged.
+ *
+ * @param cursor Cursor positioned at a value by `kv_parse_pread_check_key()`.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the value is too large, empty, or longer than KV_PARSE_PREAD_BLOCK.
+ */
+size_t kv_parse_pread_get_value(const kv_parse_cursor *cursor, char *value, size_t value_max);
+
+/**
+ * @brief Parses and extracts an INI/TOML-style section header from the current line.
+ *
+ * Same as `kv_parse_check_section()`.
+ *
+ * @param cursor Cursor positioned on a line.
+ * @param section Buffer to store the extracted section name.
+ * @param section_max Maximum size of the buffer (including null terminator).
+ *
+ * @return The length of the extracted section name on success, 0 on failure.
+ */
+size_t kv_parse_pread_check_section(const kv_parse_cursor *cursor, char *section, size_t section_max);
+
+/**
+ * @brief Extracts the value associated with a key from a file.
+ *
+ * Scans the file from the start a block at a time, so a lookup costs one `pread()` per
+ * KV_PARSE_PREAD_BLOCK bytes. Duplicate keys return the first occurrence.
+ *
+ * @param fd File descriptor open for reading. Must support `pread()` (regular files).
+ * @param key The key to search for.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the key is missing, the value is too large,
+ *         empty, or on a line longer than KV_PARSE_PREAD_BLOCK.
+ *
+ * @note A key whose line is longer than KV_PARSE_PREAD_BLOCK returns 0 with an empty value, exactly as
+ *       a missing key does. Use the cursor functions (or a larger KV_PARSE_PREAD_BLOCK) when such lines
+ *       must be told apart.
+ */
+size_t kv_parse_pread_get(int fd, const char *key, char *value, size_t value_max);
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file kv_parse_reader.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a block reader for the FILE parser. The file is read with `fread()` into a
+ * caller supplied block and each line is parsed in place with the span API of the buffer parser.
+ * Backtracking after a failed key match is a pointer reset instead of an `fseek()`.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#include "kv_parse_reader.h"
+#include "kv_parse_buffer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+static void kv_parse_reader_fill_line(kv_parse_reader *reader)
+{
+    char *search = reader->line;
+
+    reader->truncated = false;
+    for (;;)
+    {
+        /* Check For End Of Line In Buffered Data */
+        char *newline = memchr(search, '\n', (size_t)(reader->data_end - search));
+        if (newline != NULL)
+        {
+            reader->line_end = newline;
+            break;
+        }
+
+        if (reader->eof)
+        {
+            /* Last line has no newline */
+            reader->line_end = reader->data_end;
+            break;
+        }
+
+        size_t kept = (size_t)(reader->data_end - reader->line);
+        if (kept == reader->block_size)
+        {
+            /* Line longer than the block */
+            reader->line_end = reader->data_end;
+            reader->truncated = true;
+            break;
+        }
+
+        /* Line continues past the buffered data. Move it to the front of the block and read more */
+        memmove(reader->block, reader->line, kept);
+        reader->line = reader->block;
+        reader->data_end = reader->block + kept;
+        search = reader->data_end;
+
+        size_t count = fread(reader->data_end, 1, reader->block_size - kept, reader->file);
+        if (count == 0)
+        {
+            reader->eof = true;
+        }
+        reader->data_end += count;
+    }
+
+    reader->pos = reader->line;
+}
+
+void kv_parse_reader_init(kv_parse_reader *reader, FILE *file, char *block, size_t block_size)
+{
+    reader->file = file;
+    reader->block = block;
+    reader->block_size = block_size;
+    reader->data_end = block;
+    reader->eof = false;
+    reader->line = block;
+    reader->line_end = block;
+    reader->pos = block;
+    reader->truncated = false;
+}
+
+void kv_parse_reader_rewind(kv_parse_reader *reader)
+{
+    rewind(reader->file);
+    kv_parse_reader_init(reader, reader->file, reader->block, reader->block_size);
+}
+
+bool kv_parse_reader_next_line(kv_parse_reader *reader, size_t line_count)
+{
+    /* Check if first line */
+    if (line_count == 0)
+    {
+        /* Already at next line */
+        kv_parse_reader_fill_line(reader);
+        return true;
+    }
+
+    /* Discard the rest of a line longer than the block */
+    while (reader->truncated)
+    {
+        reader->line = reader->data_end;
+        kv_parse_reader_fill_line(reader);
+    }
+
+    if (reader->line_end == reader->data_end)
+    {
+        /* File Finished Reading */
+        return false;
+    }
+
+    /* Advance to next line */
+    reader->line = reader->line_end + 1;
+    kv_parse_reader_fill_line(reader);
+    return reader->line != reader->data_end;
+}
+
+bool kv_parse_reader_check_key(kv_parse_reader *reader, const char *key)
+{
+    const char *value = kv_parse_span_check_key(reader->line, reader->line_end, key);
+    if (value == NULL)
+    {
+        /* Key was not found. Backtrack to start of line */
+        reader->pos = reader->line;
+        return false;
+    }
+
+    /* Key Found. Next position is the value */
+    reader->pos = value;
+    return true;
+}
+
+size_t kv_parse_reader_get_value(kv_parse_reader *reader, char *value, size_t value_max)
+{
+    if (reader->truncated)
+    {
+        /* Value may continue past the block. Don't return a value. */
+        value[0] = '\0';
+        return 0;
+    }
+
+    return kv_parse_span_get_value(reader->pos, reader->line_end, value, value_max);
+}
+
+size_t kv_parse_reader_check_section(kv_parse_reader *reader, char *section, size_t section_max)
+{
+    return kv_parse_span_check_section(reader->line, reader->line_end, section, section_max);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file kv_parse_reader.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a block reader for the FILE parser. The file is read with `fread()` into a
+ * caller supplied block and each line is parsed in place with the span API of the buffer parser.
+ * Backtracking after a failed key match is a pointer reset instead of an `fseek()`.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * char block[4096];
+ * kv_parse_reader reader;
+ * kv_parse_reader_init(&reader, file, block, sizeof(block));
+ * for (size_t line = 0; kv_parse_reader_next_line(&reader, line); line++)
+ * {
+ *     if (kv_parse_reader_check_key(&reader, key))
+ *     {
+ *         return kv_parse_reader_get_value(&reader, value, value_max);
+ *     }
+ * }
+ * @endcode
+ */
+#ifndef KV_PARSE_READER_H
+#define KV_PARSE_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief Block reader state.
+ *
+ * The current line always sits whole inside the block between `line` and `line_end`,
+ * unless it is longer than the block, in which case `truncated` is set.
+ */
+typedef struct kv_parse_reader
+{
+    FILE *file;
+    char *block;
+    size_t block_size;
+
+    /* Valid data in block */
+    char *data_end;
+    bool eof;
+
+    /* Current line and position within it */
+    char *line;
+    char *line_end;
+    const char *pos;
+    bool truncated;
+} kv_parse_reader;
+
+/**
+ * @brief Binds a reader to a file stream and a caller supplied block buffer.
+ *
+ * @param reader Reader to initialise.
+ * @param file Pointer to the file stream. Reading starts from its current position.
+ * @param block Buffer used to hold data read from the file. Lines longer than this cannot return values.
+ * @param block_size Size of the block buffer.
+ */
+void kv_parse_reader_init(kv_parse_reader *reader, FILE *file, char *block, size_t block_size);
+
+/**
+ * @brief Rewinds the file stream and discards any buffered data.
+ *
+ * @param reader Reader to rewind.
+ */
+void kv_parse_reader_rewind(kv_parse_reader *reader);
+
+/**
+ * @brief Advances the reader to the next line.
+ *
+ * Same as `kv_parse_next_line()` but reads ahead a block at a time.
+ *
+ * @param reader Reader bound to a file with `kv_parse_reader_init()`.
+ * @param line_count The current line number (0-based). If line_count is 0, the function
+ *        does not advance and returns true.
+ *
+ * @return true if the function successfully moves to the next line, false if EOF is reached.
+ */
+bool kv_parse_reader_next_line(kv_parse_reader *reader, size_t line_count);
+
+/**
+ * @brief Checks if the current line contains the specified key.
+ *
+ * Same as `kv_parse_check_key()`. On a match the reader position moves to the value,
+ * otherwise it stays at the start of the line.
+ *
+ * @param reader Reader positioned on a line.
+ * @param key The key to search for.
+ *
+ * @return true if the key is found, false otherwise.
+ */
+bool kv_parse_reader_check_key(kv_parse_reader *reader, const char *key);
+
+/**
+ * @brief Extracts the value at the reader position.
+ *
+ * Same as `kv_parse_get_value()`. The reader position is left unchanged.
+ *
+ * @param reader Reader positioned at a value by `kv_parse_reader_check_key()`.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the value is too large, empty, or on a line longer than the block.
+ */
+size_t kv_parse_reader_get_value(kv_parse_reader *reader, char *value, size_t value_max);
+
+/**
+ * @brief Parses and extracts an INI/TOML-style section header from the current line.
+ *
+ * Same as `kv_parse_check_section()`.
+ *
+ * @param reader Reader positioned on a line.
+ * @param section Buffer to store the extracted section name.
+ * @param section_max Maximum size of the buffer (including null terminator).
+ *
+ * @return The length of the extracted section name on success, 0 on failure.
+ */
+size_t kv_parse_reader_check_section(kv_parse_reader *reader, char *section, size_t section_max);
+
+#endif
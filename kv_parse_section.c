@@ -0,0 +1,195 @@
+/**
+ * @file kv_parse_section.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a section directory for the buffer parser. Section headers are located once
+ * and each section's byte range recorded, so a key can be looked up within one section without
+ * scanning the unrelated sections around it.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#include "kv_parse_section.h"
+#include "kv_parse_buffer.h"
+#include "kv_parse_class.h"
+#include "kv_parse_key.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Returns the first range with the name, plus one, or 0 if the name is missing */
+static size_t kv_parse_section_lookup(const kv_parse_sections *dir, const char *name, size_t name_len, uint32_t hash)
+{
+    if (dir->capacity == 0 || dir->count == 0)
+    {
+        return 0;
+    }
+
+    /* Walk the interned names of the bucket */
+    for (size_t i = dir->section[hash % dir->capacity].head; i != 0; i = dir->section[i - 1].next)
+    {
+        const kv_parse_section *section = &dir->section[i - 1];
+        if (section->hash == hash && section->name_len == name_len && memcmp(section->name, name, name_len) == 0)
+        {
+            /* First occurrence holds the interned id */
+            return i;
+        }
+    }
+    return 0;
+}
+
+static bool kv_parse_section_add(kv_parse_sections *dir, const char *name, size_t name_len, const char *start)
+{
+    kv_parse_section *section = &dir->section[dir->count];
+    uint32_t hash = kv_parse_key_hash(name, name_len);
+
+    /* Intern section name */
+    size_t first = kv_parse_section_lookup(dir, name, name_len, hash);
+    if (first == 0 && dir->names > UINT16_MAX)
+    {
+        /* No id left for another name */
+        return false;
+    }
+
+    section->name = name;
+    section->name_len = name_len;
+    section->hash = hash;
+    section->start = start;
+    section->end = start;
+    section->next = 0;
+    section->repeat = 0;
+    section->last = dir->count + 1;
+    if (first != 0)
+    {
+        /* Repeated name. Append the range to the chain of the first occurrence */
+        kv_parse_section *origin = &dir->section[first - 1];
+        section->id = origin->id;
+        dir->section[origin->last - 1].repeat = dir->count + 1;
+        origin->last = dir->count + 1;
+    }
+    else
+    {
+        /* New name. Chain it into its bucket */
+        size_t *head = &dir->section[hash % dir->capacity].head;
+        section->id = (uint16_t)dir->names++;
+        section->next = *head;
+        *head = dir->count + 1;
+    }
+    dir->count++;
+    return true;
+}
+
+void kv_parse_sections_init(kv_parse_sections *dir, kv_parse_section *storage, size_t capacity)
+{
+    dir->buffer = NULL;
+    dir->count = 0;
+    dir->capacity = capacity;
+    dir->names = 0;
+    dir->section = storage;
+}
+
+bool kv_parse_buffer_sections(kv_parse_sections *dir, const char *str)
+{
+    dir->buffer = str;
+    dir->count = 0;
+    dir->names = 0;
+
+    if (dir->capacity == 0)
+    {
+        return false;
+    }
+
+    /* Empty name buckets */
+    for (size_t i = 0; i < dir->capacity; i++)
+    {
+        dir->section[i].head = 0;
+    }
+
+    /* Unnamed section before the first header */
+    kv_parse_section_add(dir, "", 0, str);
+
+    while (*str != '\0')
+    {
+        const char *line = str;
+        const char *eol = kv_parse_buffer_scan_line((char *)line);
+        str = (*eol == '\n') ? eol + 1 : eol;
+
+        /* Check For INI/TOML Section Opening Delimiter */
+        if (*line != '[')
+        {
+            continue;
+        }
+
+        /* Find last non whitespace character of the line */
+        const char *last = memchr(line, '\r', (size_t)(eol - line));
+        if (last == NULL)
+        {
+            last = eol;
+        }
+        while (last > line + 1 && KV_PARSE_IS(last[-1], KV_PARSE_CLASS_SPACE))
+        {
+            last--;
+        }
+
+        /* Expecting closing bracket. "[]" has no name and is not a header, as in `kv_parse_buffer_check_section()` */
+        if (last <= line + 2 || last[-1] != ']')
+        {
+            continue;
+        }
+
+        /* Header ends the previous section */
+        dir->section[dir->count - 1].end = line;
+
+        if (dir->count >= dir->capacity)
+        {
+            /* Directory full */
+            return false;
+        }
+
+        if (!kv_parse_section_add(dir, line + 1, (size_t)(last - 1 - (line + 1)), str))
+        {
+            /* Too many distinct names */
+            return false;
+        }
+    }
+
+    /* Last section runs to the end of the buffer */
+    dir->section[dir->count - 1].end = str;
+    return true;
+}
+
+static size_t kv_parse_sections_first(const kv_parse_sections *dir, const char *section)
+{
+    size_t len = strlen(section);
+    return kv_parse_section_lookup(dir, section, len, kv_parse_key_hash(section, len));
+}
+
+int kv_parse_sections_find(const kv_parse_sections *dir, const char *section)
+{
+    size_t first = kv_parse_sections_first(dir, section);
+    return (first != 0) ? dir->section[first - 1].id : -1;
+}
+
+size_t kv_parse_buffer_section_get(const kv_parse_sections *dir, const char *section, const char *key, char *value, size_t value_max)
+{
+    /* Follow the ranges of the section in buffer order */
+    for (size_t i = kv_parse_sections_first(dir, section); i != 0; i = dir->section[i - 1].repeat)
+    {
+        /* Scan the section range only */
+        const char *str = dir->section[i - 1].start;
+        const char *end = dir->section[i - 1].end;
+        for (size_t line = 0; (str = kv_parse_span_next_line(str, end, line)) != NULL; line++)
+        {
+            const char *input_value = NULL;
+            if ((input_value = kv_parse_span_check_key(str, end, key)) != NULL)
+            {
+                return kv_parse_span_get_value(input_value, end, value, value_max);
+            }
+        }
+    }
+
+    /* Section or key not found */
+    value[0] = '\0';
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file kv_parse_section.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a section directory for the buffer parser. Section headers are located once
+ * and each section's byte range recorded, so a key can be looked up within one section without
+ * scanning the unrelated sections around it.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * static kv_parse_section storage[64];
+ * kv_parse_sections dir;
+ * kv_parse_sections_init(&dir, storage, 64);
+ * kv_parse_buffer_sections(&dir, input);
+ * return kv_parse_buffer_section_get(&dir, "db", "host", value, value_max);
+ * @endcode
+ */
+#ifndef KV_PARSE_SECTION_H
+#define KV_PARSE_SECTION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Byte range of one section of a buffer.
+ *
+ * Range 0 is the implicit unnamed section before the first header. Every `[section]` header
+ * starts a new range running from the line after the header up to the next header, so range i
+ * holds the records with section id i from `kv_parse_buffer_iter_next()` and the index. A `[]`
+ * line has no name and is not a header, as in `kv_parse_buffer_check_section()`.
+ */
+typedef struct kv_parse_section
+{
+    const char *name; /* Section name without brackets. Not null terminated */
+    size_t name_len;
+    uint32_t hash;
+    uint16_t id;       /* Interned name. Repeated headers share the id of the first occurrence */
+    const char *start; /* First line of the section body */
+    const char *end;   /* Start of the next header line, or end of buffer */
+
+    /* Name hash table, threaded through the array. Entry i also heads bucket i */
+    size_t head; /* First interned name in bucket i, plus one. 0 if empty */
+    size_t next; /* Next interned name in the same bucket as this one, plus one */
+
+    /* Ranges of one name, chained in buffer order from the first occurrence */
+    size_t repeat; /* Next range with the same name, plus one. 0 if this is the last */
+    size_t last;   /* First occurrence only: last range with the same name, plus one */
+} kv_parse_section;
+
+/**
+ * @brief Section directory over a buffer, stored in a caller supplied array.
+ */
+typedef struct kv_parse_sections
+{
+    const char *buffer;
+    size_t count;
+    size_t capacity;
+    size_t names; /* Number of distinct section names (ids 0 to names - 1) */
+    kv_parse_section *section;
+} kv_parse_sections;
+
+/**
+ * @brief Binds a section directory to a caller supplied array.
+ *
+ * @param dir Directory to initialise.
+ * @param storage Array of at least `capacity` sections. Must outlive the directory.
+ * @param capacity Maximum number of section ranges, including the unnamed range before the first header.
+ */
+void kv_parse_sections_init(kv_parse_sections *dir, kv_parse_section *storage, size_t capacity);
+
+/**
+ * @brief Records the byte range of every section of a buffer.
+ *
+ * Headers are detected with the same rules as `kv_parse_buffer_check_section()`. Only the first
+ * byte of each line is examined unless it opens a header, so key value lines are not parsed.
+ * Names are interned through a hash table kept in the same array, so each header costs about
+ * one name comparison however many sections there are.
+ *
+ * @param dir Directory bound to storage with `kv_parse_sections_init()`. Any previous content is discarded.
+ * @param str Buffer to scan. Must outlive the directory as ranges point into it.
+ *
+ * @return true if every section was recorded, false if the buffer holds more sections than the directory capacity
+ *         or more than UINT16_MAX + 1 distinct names (ids are 16 bit). On false the directory still covers the
+ *         sections before the one that did not fit.
+ */
+bool kv_parse_buffer_sections(kv_parse_sections *dir, const char *str);
+
+/**
+ * @brief Looks up the interned id of a section name.
+ *
+ * @param dir Directory filled by `kv_parse_buffer_sections()`.
+ * @param section Section name without brackets. "" names the unnamed range before the first header.
+ *
+ * @return The section id, or -1 if the section is missing.
+ */
+int kv_parse_sections_find(const kv_parse_sections *dir, const char *section);
+
+/**
+ * @brief Extracts the value associated with a key within one section.
+ *
+ * Only the ranges of the named section are scanned, each ending at the next header. The ranges
+ * are found through the name hash table and the chain of repeats, not by walking the directory.
+ * If the section header is repeated, its ranges are searched in order and the first occurrence wins.
+ *
+ * @param dir Directory filled by `kv_parse_buffer_sections()`.
+ * @param section Section name without brackets. "" names the unnamed range before the first header.
+ * @param key The key to search for.
+ * @param value Buffer to store the extracted value.
+ * @param value_max Maximum size of the value buffer.
+ *
+ * @return The length of the extracted value, or 0 if the section or key is missing, the value is too large or empty.
+ */
+size_t kv_parse_buffer_section_get(const kv_parse_sections *dir, const char *section, const char *key, char *value, size_t value_max);
+
+#endif
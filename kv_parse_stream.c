@@ -0,0 +1,419 @@
+/**
+ * @file kv_parse_stream.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a push style streaming parser for inputs that cannot seek, such as pipes,
+ * sockets and stdin. Input is fed in chunks of any size and completed key value records are
+ * returned one at a time. All parser state is carried across chunks, so a chunk may end anywhere
+ * (mid key, inside a quoted value, between '\r' and '\n'). Memory use is bounded by the caller
+ * supplied key, value and section buffers.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#include "kv_parse_stream.h"
+#include "kv_parse_class.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Parser States */
+enum
+{
+    KV_PARSE_STREAM_LINE_START,
+    KV_PARSE_STREAM_KEY_LEAD,
+    KV_PARSE_STREAM_KEY,
+    KV_PARSE_STREAM_VALUE_LEAD,
+    KV_PARSE_STREAM_VALUE,
+    KV_PARSE_STREAM_ESCAPE,
+    KV_PARSE_STREAM_SECTION,
+    KV_PARSE_STREAM_SKIP_LINE,
+};
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+static void kv_parse_stream_put_value(kv_parse_stream *stream, char ch)
+{
+    if (stream->value_len < stream->value_max - 1)
+    {
+        stream->value[stream->value_len++] = ch;
+    }
+    else
+    {
+        stream->overflow = true;
+    }
+}
+
+static int kv_parse_stream_hex_digit(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+    {
+        return ch - '0';
+    }
+    else if (ch >= 'a' && ch <= 'f')
+    {
+        return ch - 'a' + 10;
+    }
+    else if (ch >= 'A' && ch <= 'F')
+    {
+        return ch - 'A' + 10;
+    }
+    return -1;
+}
+
+/* Keeps the bytes of an incomplete escape sequence as they were */
+static void kv_parse_stream_escape_literal(kv_parse_stream *stream)
+{
+    kv_parse_stream_put_value(stream, '\\');
+    if (stream->escape >= 2)
+    {
+        kv_parse_stream_put_value(stream, 'x');
+    }
+    if (stream->escape >= 3)
+    {
+        kv_parse_stream_put_value(stream, stream->escape_hex);
+    }
+    stream->escape = 0;
+}
+
+/**
+ * Feeds the next byte of an escape sequence. `escape` counts the bytes seen so far (1 after the backslash,
+ * 2 after an 'x', 3 after the first hex digit). Returns false if the byte does not continue the sequence,
+ * in which case the bytes seen are kept as is and the byte must be parsed normally.
+ */
+static bool kv_parse_stream_escape(kv_parse_stream *stream, char ch)
+{
+    if (stream->escape == 1)
+    {
+        switch (ch)
+        {
+            case '\\':
+            case '"':
+            case '\'':
+                break;
+            case 'n':
+                ch = '\n';
+                break;
+            case 't':
+                ch = '\t';
+                break;
+            case 'r':
+                ch = '\r';
+                break;
+            case '0':
+                ch = '\0';
+                break;
+            case 'x':
+                stream->escape = 2;
+                return true;
+            default:
+                kv_parse_stream_escape_literal(stream);
+                return false;
+        }
+
+        kv_parse_stream_put_value(stream, ch);
+        stream->escape = 0;
+        return true;
+    }
+
+    if (kv_parse_stream_hex_digit(ch) < 0)
+    {
+        kv_parse_stream_escape_literal(stream);
+        return false;
+    }
+
+    if (stream->escape == 2)
+    {
+        stream->escape_hex = ch;
+        stream->escape = 3;
+        return true;
+    }
+
+    kv_parse_stream_put_value(stream, (char)(kv_parse_stream_hex_digit(stream->escape_hex) * 16 + kv_parse_stream_hex_digit(ch)));
+    stream->escape = 0;
+    return true;
+}
+#endif
+
+static void kv_parse_stream_end_value(kv_parse_stream *stream)
+{
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    if (stream->escape > 0)
+    {
+        /* Line ended mid escape sequence */
+        kv_parse_stream_escape_literal(stream);
+    }
+#endif
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (stream->value_len > 0 && KV_PARSE_IS(stream->value[stream->value_len - 1], KV_PARSE_CLASS_SPACE))
+    {
+        stream->value_len--;
+    }
+#endif
+    stream->value[stream->value_len] = '\0';
+
+    if (stream->overflow)
+    {
+        /* Key or value did not fit. Don't return a record. */
+        stream->dropped++;
+        return;
+    }
+
+    stream->ready = true;
+}
+
+static void kv_parse_stream_end_section(kv_parse_stream *stream)
+{
+    size_t i = stream->section_len;
+
+    /* Expecting closing bracket. Clear section if missing */
+    while (i > 0 && KV_PARSE_IS(stream->section[i - 1], KV_PARSE_CLASS_SPACE))
+    {
+        i--;
+    }
+
+    if (stream->overflow || i == 0 || stream->section[i - 1] != ']')
+    {
+        i = 1;
+    }
+
+    /* Exclude closing bracket */
+    stream->section_len = i - 1;
+    stream->section[stream->section_len] = '\0';
+}
+
+void kv_parse_stream_init(kv_parse_stream *stream, char *key, size_t key_max, char *value, size_t value_max, char *section, size_t section_max)
+{
+    stream->key = key;
+    stream->key_len = 0;
+    stream->key_max = key_max;
+    stream->value = value;
+    stream->value_len = 0;
+    stream->value_max = value_max;
+    stream->section = section;
+    stream->section_len = 0;
+    stream->section_max = section_max;
+    stream->line = 0;
+    stream->line_count = 0;
+    stream->ready = false;
+    stream->dropped = 0;
+    stream->state = KV_PARSE_STREAM_LINE_START;
+    stream->quote = '\0';
+    stream->escape = 0;
+    stream->overflow = false;
+
+    key[0] = '\0';
+    value[0] = '\0';
+    if (section != NULL)
+    {
+        section[0] = '\0';
+    }
+}
+
+size_t kv_parse_stream_feed(kv_parse_stream *stream, const char *data, size_t len)
+{
+    size_t i = 0;
+
+    stream->ready = false;
+    while (i < len && !stream->ready)
+    {
+        char ch = data[i];
+
+        switch (stream->state)
+        {
+            case KV_PARSE_STREAM_LINE_START:
+                /* Start Of Line. Record is not consumed yet */
+                stream->line = stream->line_count;
+                stream->key_len = 0;
+                stream->value_len = 0;
+                stream->quote = '\0';
+                stream->escape = 0;
+                stream->overflow = false;
+
+                /* Check For INI/TOML Section Opening Delimiter */
+                if (ch == '[' && stream->section != NULL)
+                {
+                    stream->section_len = 0;
+                    stream->state = KV_PARSE_STREAM_SECTION;
+                    i++;
+                    continue;
+                }
+
+                stream->state = KV_PARSE_STREAM_KEY_LEAD;
+                continue;
+
+            case KV_PARSE_STREAM_KEY_LEAD:
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                if (KV_PARSE_IS(ch, KV_PARSE_CLASS_SPACE))
+                {
+                    i++;
+                    continue;
+                }
+#endif
+                stream->state = KV_PARSE_STREAM_KEY;
+                continue;
+
+            case KV_PARSE_STREAM_KEY:
+                if (ch == '\n')
+                {
+                    /* End of line without key value delimiter */
+                    stream->state = KV_PARSE_STREAM_SKIP_LINE;
+                    continue;
+                }
+
+                if (KV_PARSE_IS(ch, KV_PARSE_CLASS_DELIMITER))
+                {
+                    /* Key Value Delimiter */
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                    while (stream->key_len > 0 && KV_PARSE_IS(stream->key[stream->key_len - 1], KV_PARSE_CLASS_SPACE))
+                    {
+                        stream->key_len--;
+                    }
+#endif
+                    stream->key[stream->key_len] = '\0';
+                    stream->state = KV_PARSE_STREAM_VALUE_LEAD;
+                    i++;
+                    continue;
+                }
+
+                if (stream->key_len < stream->key_max - 1)
+                {
+                    stream->key[stream->key_len++] = ch;
+                }
+                else
+                {
+                    stream->overflow = true;
+                }
+                i++;
+                continue;
+
+            case KV_PARSE_STREAM_VALUE_LEAD:
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                if (KV_PARSE_IS(ch, KV_PARSE_CLASS_SPACE))
+                {
+                    i++;
+                    continue;
+                }
+#endif
+                stream->state = KV_PARSE_STREAM_VALUE;
+                continue;
+
+            case KV_PARSE_STREAM_VALUE:
+                if (KV_PARSE_IS(ch, KV_PARSE_CLASS_EOL))
+                {
+                    /* End Of Line. Leave line ending for the line skip */
+                    kv_parse_stream_end_value(stream);
+                    stream->state = KV_PARSE_STREAM_SKIP_LINE;
+                    continue;
+                }
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+                else if (stream->quote == '\0' && KV_PARSE_IS(ch, KV_PARSE_CLASS_QUOTE))
+                {
+                    /* Start Of Quoted String */
+                    stream->quote = ch;
+                    i++;
+                    continue;
+                }
+                else if (stream->quote != '\0' && ch == stream->quote)
+                {
+                    /* End Of Quoted String. Return Value */
+                    stream->value[stream->value_len] = '\0';
+                    if (stream->overflow)
+                    {
+                        stream->dropped++;
+                    }
+                    else
+                    {
+                        stream->ready = true;
+                    }
+                    stream->state = KV_PARSE_STREAM_SKIP_LINE;
+                    i++;
+                    continue;
+                }
+                else if (stream->quote != '\0' && ch == '\\')
+                {
+                    /* Start Of Escape Sequence In Quoted String */
+                    stream->escape = 1;
+                    stream->state = KV_PARSE_STREAM_ESCAPE;
+                    i++;
+                    continue;
+                }
+#endif
+                if (stream->value_len < stream->value_max - 1)
+                {
+                    stream->value[stream->value_len++] = ch;
+                }
+                else
+                {
+                    stream->overflow = true;
+                }
+                i++;
+                continue;
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+            case KV_PARSE_STREAM_ESCAPE:
+                /* Escape Sequence In Quoted String */
+                if (kv_parse_stream_escape(stream, ch))
+                {
+                    i++;
+                }
+                if (stream->escape == 0)
+                {
+                    stream->state = KV_PARSE_STREAM_VALUE;
+                }
+                continue;
+
+#endif
+            case KV_PARSE_STREAM_SECTION:
+                if (KV_PARSE_IS(ch, KV_PARSE_CLASS_EOL))
+                {
+                    /* End Of Line (Scan for closing bracket) */
+                    kv_parse_stream_end_section(stream);
+                    stream->state = KV_PARSE_STREAM_SKIP_LINE;
+                    continue;
+                }
+
+                if (stream->section_len < stream->section_max - 1)
+                {
+                    stream->section[stream->section_len++] = ch;
+                }
+                else
+                {
+                    stream->overflow = true;
+                }
+                i++;
+                continue;
+
+            case KV_PARSE_STREAM_SKIP_LINE:
+            default:
+                if (ch == '\n')
+                {
+                    stream->line_count++;
+                    stream->state = KV_PARSE_STREAM_LINE_START;
+                }
+                i++;
+                continue;
+        }
+    }
+
+    return i;
+}
+
+bool kv_parse_stream_finish(kv_parse_stream *stream)
+{
+    stream->ready = false;
+
+    if (stream->state == KV_PARSE_STREAM_VALUE_LEAD || stream->state == KV_PARSE_STREAM_VALUE || stream->state == KV_PARSE_STREAM_ESCAPE)
+    {
+        /* End Of File Ends The Value */
+        kv_parse_stream_end_value(stream);
+    }
+    else if (stream->state == KV_PARSE_STREAM_SECTION)
+    {
+        kv_parse_stream_end_section(stream);
+    }
+
+    /* Ready for a new input */
+    stream->state = KV_PARSE_STREAM_LINE_START;
+    stream->line_count = 0;
+    return stream->ready;
+}
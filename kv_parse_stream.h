@@ -0,0 +1,118 @@
+/**
+ * @file kv_parse_stream.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains a push style streaming parser for inputs that cannot seek, such as pipes,
+ * sockets and stdin. Input is fed in chunks of any size and completed key value records are
+ * returned one at a time. All parser state is carried across chunks, so a chunk may end anywhere
+ * (mid key, inside a quoted value, between '\r' and '\n'). Memory use is bounded by the caller
+ * supplied key, value and section buffers.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * char key[64];
+ * char value[256];
+ * kv_parse_stream stream;
+ * kv_parse_stream_init(&stream, key, sizeof(key), value, sizeof(value), NULL, 0);
+ * while ((len = read(fd, chunk, sizeof(chunk))) > 0)
+ * {
+ *     for (const char *data = chunk; len > 0;)
+ *     {
+ *         size_t used = kv_parse_stream_feed(&stream, data, len);
+ *         data += used;
+ *         len -= used;
+ *         if (stream.ready)
+ *         {
+ *             printf("%s=%s\n", stream.key, stream.value);
+ *         }
+ *     }
+ * }
+ * if (kv_parse_stream_finish(&stream))
+ * {
+ *     printf("%s=%s\n", stream.key, stream.value);
+ * }
+ * @endcode
+ */
+#ifndef KV_PARSE_STREAM_H
+#define KV_PARSE_STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Streaming parser state.
+ *
+ * When `ready` is set after a call to `kv_parse_stream_feed()` or `kv_parse_stream_finish()`,
+ * `key` and `value` hold a null terminated record found on line `line` (0-based), within
+ * section `section` if a section buffer was supplied. The record stays valid until the next call.
+ */
+typedef struct kv_parse_stream
+{
+    /* Record Output */
+    char *key;
+    size_t key_len;
+    char *value;
+    size_t value_len;
+    char *section;
+    size_t section_len;
+    size_t line;
+    bool ready;
+
+    /* Records dropped because the key or value did not fit its buffer */
+    size_t dropped;
+
+    /* Parser State */
+    size_t key_max;
+    size_t value_max;
+    size_t section_max;
+    size_t line_count;
+    int state;
+    int quote;
+    int escape;
+    char escape_hex;
+    bool overflow;
+} kv_parse_stream;
+
+/**
+ * @brief Initialises a streaming parser with caller supplied record buffers.
+ *
+ * @param stream Parser to initialise.
+ * @param key Buffer to store each key.
+ * @param key_max Maximum size of the key buffer.
+ * @param value Buffer to store each value.
+ * @param value_max Maximum size of the value buffer.
+ * @param section Buffer to store the current INI/TOML-style section name, or NULL to ignore sections.
+ *                When supplied, every line starting with '[' is a section header. A malformed header clears the section.
+ * @param section_max Maximum size of the section buffer.
+ */
+void kv_parse_stream_init(kv_parse_stream *stream, char *key, size_t key_max, char *value, size_t value_max, char *section, size_t section_max);
+
+/**
+ * @brief Feeds a chunk of input to the parser.
+ *
+ * Input is consumed until a record completes or the chunk runs out. Feed the remainder of
+ * the chunk in the next call.
+ *
+ * @param stream Parser initialised with `kv_parse_stream_init()`.
+ * @param data Chunk of input.
+ * @param len Length of the chunk.
+ *
+ * @return Number of bytes consumed. `stream->ready` is set if a record completed.
+ */
+size_t kv_parse_stream_feed(kv_parse_stream *stream, const char *data, size_t len);
+
+/**
+ * @brief Signals the end of input, completing a last line without a trailing newline.
+ *
+ * The parser is reset afterwards and can be reused for a new input.
+ *
+ * @param stream Parser initialised with `kv_parse_stream_init()`.
+ *
+ * @return true if a record completed. `stream->ready` is set to match.
+ */
+bool kv_parse_stream_finish(kv_parse_stream *stream);
+
+#endif
@@ -0,0 +1,466 @@
+/**
+ * @file kv_parse_typed.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains typed value accessors for the buffer parser. Numbers, booleans, sizes and
+ * durations are parsed straight from the value in the input buffer, without first copying the
+ * value into a string buffer and parsing the copy.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#include "kv_parse_typed.h"
+#include "kv_parse_class.h"
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Digits are converted 8 at a time with unaligned 8 byte loads of bytes already known to be digits */
+#if !defined(KV_PARSE_DISABLE_SIMD) && defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define KV_PARSE_DIGIT_WORDS
+#endif
+
+/* Largest integer a double holds exactly */
+#define KV_PARSE_F64_EXACT (1ull << 53)
+
+/* Start of a value. Skips leading whitespace and an opening quote, which is returned in quote */
+static const char *kv_parse_value_start(const char *str, char *quote)
+{
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        str++;
+    }
+#endif
+
+    *quote = '\0';
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    if (KV_PARSE_IS(*str, KV_PARSE_CLASS_QUOTE))
+    {
+        *quote = *str;
+        str++;
+    }
+#endif
+    return str;
+}
+
+/* True if nothing but the closing quote, or trailing whitespace up to the line end, follows str */
+static bool kv_parse_value_finished(const char *str, char quote)
+{
+    if (quote != '\0')
+    {
+        /* Text after the closing quote is ignored, as in `kv_parse_buffer_get_value()` */
+        return *str == quote;
+    }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (KV_PARSE_IS(*str, KV_PARSE_CLASS_SPACE))
+    {
+        str++;
+    }
+#endif
+    return KV_PARSE_IS(*str, KV_PARSE_CLASS_NUL | KV_PARSE_CLASS_EOL);
+}
+
+static bool kv_parse_is_digit(char ch)
+{
+    return ch >= '0' && ch <= '9';
+}
+
+static const char *kv_parse_skip_digits(const char *str)
+{
+    while (kv_parse_is_digit(*str))
+    {
+        str++;
+    }
+    return str;
+}
+
+#ifdef KV_PARSE_DIGIT_WORDS
+/* Value of 8 digits loaded little endian. Combines digit pairs, then pairs of pairs, then the halves */
+static uint64_t kv_parse_word_digits(uint64_t word)
+{
+    word -= 0x3030303030303030ull;
+    word = (word * 10) + (word >> 8);
+    return (((word & 0x000000FF000000FFull) * 0x000F424000000064ull) + (((word >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+}
+#endif
+
+/* Converts decimal digits. Returns the end of the digits, or NULL if the value does not fit */
+static const char *kv_parse_digits(const char *str, uint64_t *value)
+{
+    uint64_t result = 0;
+#ifdef KV_PARSE_DIGIT_WORDS
+    /* Find the end of the digits first so words are only loaded from within them */
+    const char *end = kv_parse_skip_digits(str);
+    while (end - str >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, str, 8);
+
+        uint64_t eight = kv_parse_word_digits(word);
+        if (result > (UINT64_MAX - eight) / 100000000)
+        {
+            return NULL;
+        }
+        result = result * 100000000 + eight;
+        str += 8;
+    }
+#endif
+
+    for (; kv_parse_is_digit(*str); str++)
+    {
+        uint64_t digit = (uint64_t)(*str - '0');
+        if (result > (UINT64_MAX - digit) / 10)
+        {
+            return NULL;
+        }
+        result = result * 10 + digit;
+    }
+
+    *value = result;
+    return str;
+}
+
+/* Parses an optionally signed integer. Returns its end, or NULL with status set */
+static const char *kv_parse_integer(const char *str, uint64_t *magnitude, bool *negative, kv_parse_status *status)
+{
+    *negative = false;
+    if (*str == '+' || *str == '-')
+    {
+        *negative = (*str == '-');
+        str++;
+    }
+
+    if (!kv_parse_is_digit(*str))
+    {
+        *status = KV_PARSE_INVALID;
+        return NULL;
+    }
+
+    str = kv_parse_digits(str, magnitude);
+    if (str == NULL)
+    {
+        *status = KV_PARSE_OVERFLOW;
+    }
+    return str;
+}
+
+kv_parse_status kv_parse_buffer_get_i64(const char *str, int64_t *value)
+{
+    char quote;
+    str = kv_parse_value_start(str, &quote);
+    if (kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_EMPTY;
+    }
+
+    uint64_t magnitude;
+    bool negative;
+    kv_parse_status status;
+    str = kv_parse_integer(str, &magnitude, &negative, &status);
+    if (str == NULL)
+    {
+        return status;
+    }
+    else if (!kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_INVALID;
+    }
+    else if (magnitude > (uint64_t)INT64_MAX + (negative ? 1 : 0))
+    {
+        return KV_PARSE_OVERFLOW;
+    }
+
+    /* INT64_MIN has no positive counterpart */
+    *value = negative ? -(int64_t)(magnitude - 1) - 1 : (int64_t)magnitude;
+    return KV_PARSE_OK;
+}
+
+kv_parse_status kv_parse_buffer_get_u64(const char *str, uint64_t *value)
+{
+    char quote;
+    str = kv_parse_value_start(str, &quote);
+    if (kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_EMPTY;
+    }
+
+    uint64_t magnitude;
+    bool negative;
+    kv_parse_status status;
+    str = kv_parse_integer(str, &magnitude, &negative, &status);
+    if (str == NULL)
+    {
+        return status;
+    }
+    else if (negative || !kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_INVALID;
+    }
+
+    *value = magnitude;
+    return KV_PARSE_OK;
+}
+
+kv_parse_status kv_parse_buffer_get_f64(const char *str, double *value)
+{
+    static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    static const uint64_t scales[] = {1ull,         10ull,         100ull,         1000ull,         10000ull,         100000ull,         1000000ull,         10000000ull,
+                                      100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull};
+
+    char quote;
+    str = kv_parse_value_start(str, &quote);
+    if (kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_EMPTY;
+    }
+
+    const char *number = str;
+    bool negative = false;
+    if (*str == '+' || *str == '-')
+    {
+        negative = (*str == '-');
+        str++;
+    }
+
+    /* Integer Digits */
+    bool fast = true;
+    uint64_t mantissa = 0;
+    const char *end = kv_parse_digits(str, &mantissa);
+    if (end == NULL)
+    {
+        fast = false;
+        end = kv_parse_skip_digits(str);
+    }
+    size_t digits = (size_t)(end - str);
+    str = end;
+
+    /* Fraction Digits */
+    uint64_t fraction = 0;
+    size_t fraction_digits = 0;
+    if (*str == '.')
+    {
+        str++;
+        end = kv_parse_digits(str, &fraction);
+        if (end == NULL)
+        {
+            fast = false;
+            end = kv_parse_skip_digits(str);
+        }
+        fraction_digits = (size_t)(end - str);
+        str = end;
+    }
+
+    if (digits + fraction_digits == 0)
+    {
+        return KV_PARSE_INVALID;
+    }
+
+    /* Exponent */
+    int64_t exponent = 0;
+    if (*str == 'e' || *str == 'E')
+    {
+        str++;
+        bool exponent_negative = false;
+        if (*str == '+' || *str == '-')
+        {
+            exponent_negative = (*str == '-');
+            str++;
+        }
+
+        if (!kv_parse_is_digit(*str))
+        {
+            return KV_PARSE_INVALID;
+        }
+
+        uint64_t magnitude = 0;
+        end = kv_parse_digits(str, &magnitude);
+        if (end == NULL || magnitude > 9999)
+        {
+            fast = false;
+            end = kv_parse_skip_digits(str);
+        }
+        exponent = exponent_negative ? -(int64_t)magnitude : (int64_t)magnitude;
+        str = end;
+    }
+
+    const char *number_end = str;
+    if (!kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_INVALID;
+    }
+
+    /* Fast Path. Mantissa and power of ten are exact doubles, so one rounding gives the exact result */
+    if (fast && fraction_digits < sizeof(scales) / sizeof(scales[0]) && mantissa <= KV_PARSE_F64_EXACT / scales[fraction_digits])
+    {
+        mantissa = mantissa * scales[fraction_digits] + fraction;
+        exponent -= (int64_t)fraction_digits;
+        if (mantissa <= KV_PARSE_F64_EXACT && exponent >= -22 && exponent <= 22)
+        {
+            double result = (double)mantissa;
+            result = (exponent < 0) ? result / powers[-exponent] : result * powers[exponent];
+            *value = negative ? -result : result;
+            return KV_PARSE_OK;
+        }
+    }
+
+    /* Slow Path. Same digits parsed by the C library */
+    errno = 0;
+    char *strtod_end = NULL;
+    double result = strtod(number, &strtod_end);
+    if (strtod_end != number_end)
+    {
+        /* Decimal point of the current locale is not '.' */
+        return KV_PARSE_INVALID;
+    }
+    else if (errno == ERANGE && (result == HUGE_VAL || result == -HUGE_VAL))
+    {
+        return KV_PARSE_OVERFLOW;
+    }
+
+    *value = result;
+    return KV_PARSE_OK;
+}
+
+static char kv_parse_lower(char ch)
+{
+    return (ch >= 'A' && ch <= 'Z') ? (char)(ch - 'A' + 'a') : ch;
+}
+
+kv_parse_status kv_parse_buffer_get_bool(const char *str, bool *value)
+{
+    static const struct
+    {
+        const char *word;
+        bool value;
+    } words[] = {{"true", true}, {"yes", true}, {"on", true}, {"1", true}, {"false", false}, {"no", false}, {"off", false}, {"0", false}};
+
+    char quote;
+    str = kv_parse_value_start(str, &quote);
+    if (kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_EMPTY;
+    }
+
+    for (size_t w = 0; w < sizeof(words) / sizeof(words[0]); w++)
+    {
+        /* Case insensitive compare. Stops at the first mismatch, so never reads past the terminator */
+        size_t i = 0;
+        while (words[w].word[i] != '\0' && kv_parse_lower(str[i]) == words[w].word[i])
+        {
+            i++;
+        }
+
+        if (words[w].word[i] == '\0' && kv_parse_value_finished(str + i, quote))
+        {
+            *value = words[w].value;
+            return KV_PARSE_OK;
+        }
+    }
+
+    return KV_PARSE_INVALID;
+}
+
+kv_parse_status kv_parse_buffer_get_size(const char *str, size_t *value)
+{
+    char quote;
+    str = kv_parse_value_start(str, &quote);
+    if (kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_EMPTY;
+    }
+
+    uint64_t magnitude;
+    bool negative;
+    kv_parse_status status;
+    str = kv_parse_integer(str, &magnitude, &negative, &status);
+    if (str == NULL)
+    {
+        return status;
+    }
+
+    /* Binary Unit Suffix */
+    unsigned shift = 0;
+    switch (*str)
+    {
+        case 'k':
+        case 'K':
+            shift = 10;
+            str++;
+            break;
+        case 'M':
+            shift = 20;
+            str++;
+            break;
+        case 'G':
+            shift = 30;
+            str++;
+            break;
+    }
+
+    if (negative || !kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_INVALID;
+    }
+    else if (magnitude > (uint64_t)(SIZE_MAX >> shift))
+    {
+        return KV_PARSE_OVERFLOW;
+    }
+
+    *value = (size_t)magnitude << shift;
+    return KV_PARSE_OK;
+}
+
+kv_parse_status kv_parse_buffer_get_duration(const char *str, uint64_t *ms)
+{
+    char quote;
+    str = kv_parse_value_start(str, &quote);
+    if (kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_EMPTY;
+    }
+
+    uint64_t magnitude;
+    bool negative;
+    kv_parse_status status;
+    str = kv_parse_integer(str, &magnitude, &negative, &status);
+    if (str == NULL)
+    {
+        return status;
+    }
+
+    /* Time Unit Suffix */
+    uint64_t scale = 1;
+    if (str[0] == 'm' && str[1] == 's')
+    {
+        str += 2;
+    }
+    else if (str[0] == 's')
+    {
+        scale = 1000;
+        str++;
+    }
+    else if (str[0] == 'm')
+    {
+        scale = 60000;
+        str++;
+    }
+
+    if (negative || !kv_parse_value_finished(str, quote))
+    {
+        return KV_PARSE_INVALID;
+    }
+    else if (magnitude > UINT64_MAX / scale)
+    {
+        return KV_PARSE_OVERFLOW;
+    }
+
+    *ms = magnitude * scale;
+    return KV_PARSE_OK;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file kv_parse_typed.h
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains typed value accessors for the buffer parser. Numbers, booleans, sizes and
+ * durations are parsed straight from the value in the input buffer, without first copying the
+ * value into a string buffer and parsing the copy.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ *
+ * @example Usage Example:
+ * @code
+ * int64_t port = 8080;
+ * char *input_value = kv_parse_buffer_check_key(input, "port");
+ * if (input_value != NULL && kv_parse_buffer_get_i64(input_value, &port) != KV_PARSE_OK)
+ * {
+ *     // Malformed value. Keep the default
+ * }
+ * @endcode
+ */
+#ifndef KV_PARSE_TYPED_H
+#define KV_PARSE_TYPED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Result of a typed value accessor.
+ *
+ * On anything other than KV_PARSE_OK the output is left unchanged.
+ */
+typedef enum kv_parse_status
+{
+    KV_PARSE_OK = 0,   /* Value parsed */
+    KV_PARSE_EMPTY,    /* Value is empty */
+    KV_PARSE_INVALID,  /* Value is not in the expected format */
+    KV_PARSE_OVERFLOW, /* Value is out of range for the type */
+} kv_parse_status;
+
+/**
+ * @brief Parses a signed decimal integer value.
+ *
+ * Accepts an optional '+' or '-' sign followed by decimal digits. Whitespace is skipped around the
+ * value and, unless KV_PARSE_DISABLE_QUOTED_STRINGS is defined, the value may be enclosed in quotes.
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ * @param value Set to the parsed value.
+ *
+ * @return KV_PARSE_OK, or why the value could not be parsed.
+ *
+ * @note Unless KV_PARSE_DISABLE_SIMD is defined, digits are converted 8 at a time on little endian GCC/Clang targets.
+ *       Only bytes already scanned as digits are loaded.
+ */
+kv_parse_status kv_parse_buffer_get_i64(const char *str, int64_t *value);
+
+/**
+ * @brief Parses an unsigned decimal integer value.
+ *
+ * Same as `kv_parse_buffer_get_i64()` but a '-' sign is invalid.
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ * @param value Set to the parsed value.
+ *
+ * @return KV_PARSE_OK, or why the value could not be parsed.
+ */
+kv_parse_status kv_parse_buffer_get_u64(const char *str, uint64_t *value);
+
+/**
+ * @brief Parses a decimal floating point value.
+ *
+ * Accepts an optional sign, digits with an optional decimal point and an optional exponent
+ * (e.g. "-1.5e3"). Values with at most 15 significant digits and a small exponent are converted
+ * exactly without calling `strtod()`. Other values fall back to `strtod()`, which uses the C locale
+ * decimal point.
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ * @param value Set to the parsed value.
+ *
+ * @return KV_PARSE_OK, or why the value could not be parsed. Values too large for a double overflow.
+ */
+kv_parse_status kv_parse_buffer_get_f64(const char *str, double *value);
+
+/**
+ * @brief Parses a boolean value.
+ *
+ * Accepts "true", "yes", "on" and "1" as true and "false", "no", "off" and "0" as false, in any case.
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ * @param value Set to the parsed value.
+ *
+ * @return KV_PARSE_OK, or why the value could not be parsed.
+ */
+kv_parse_status kv_parse_buffer_get_bool(const char *str, bool *value);
+
+/**
+ * @brief Parses a byte size value.
+ *
+ * Accepts an unsigned integer optionally followed by 'k' or 'K' (1024), 'M' (1024^2) or 'G' (1024^3).
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ * @param value Set to the size in bytes.
+ *
+ * @return KV_PARSE_OK, or why the value could not be parsed.
+ */
+kv_parse_status kv_parse_buffer_get_size(const char *str, size_t *value);
+
+/**
+ * @brief Parses a duration value.
+ *
+ * Accepts an unsigned integer optionally followed by "ms", "s" or "m" (minutes). Without a suffix
+ * the value is in milliseconds.
+ *
+ * @param str Pointer to the start of the value in the key-value pair.
+ * @param ms Set to the duration in milliseconds.
+ *
+ * @return KV_PARSE_OK, or why the value could not be parsed.
+ */
+kv_parse_status kv_parse_buffer_get_duration(const char *str, uint64_t *ms);
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file kvc.c
+ * @brief Composible ANSI C Key-Value Parser
+ *
+ * This file contains the `kvc` config compiler. It compiles a key value text file into the binary
+ * image read by `kv_parse_kvc_open()`:
+ *
+ *   ./kvc settings.env settings.kvc
+ *
+ * The image is written next to the output under a temporary name and renamed over it, so readers
+ * that map the old image keep a consistent copy and new readers see either image whole.
+ *
+ * Copyright (c) 2025 Brian Khuu
+ * MIT licensed
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "kv_parse_kvc.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char *kvc_read(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    size_t size = 0;
+    size_t capacity = 64 * 1024;
+    char *data = malloc(capacity + 1);
+    while (data != NULL)
+    {
+        size += fread(data + size, 1, capacity - size, file);
+        if (size < capacity)
+        {
+            break;
+        }
+
+        capacity *= 2;
+        char *grown = realloc(data, capacity + 1);
+        if (grown == NULL)
+        {
+            free(data);
+        }
+        data = grown;
+    }
+
+    if (data != NULL && ferror(file))
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+
+    if (data != NULL)
+    {
+        data[size] = '\0';
+    }
+    return data;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: kvc input output\n");
+        return 2;
+    }
+
+    char *input = kvc_read(argv[1]);
+    if (input == NULL)
+    {
+        fprintf(stderr, "kvc: could not read %s\n", argv[1]);
+        return 1;
+    }
+
+    size_t bound = kv_parse_kvc_compile(input, NULL, 0);
+    unsigned char *image = bound > 0 ? malloc(bound) : NULL;
+    size_t size = image != NULL ? kv_parse_kvc_compile(input, image, bound) : 0;
+    free(input);
+    if (size == 0)
+    {
+        fprintf(stderr, "kvc: %s is too large to compile\n", argv[1]);
+        free(image);
+        return 1;
+    }
+
+    size_t path_len = strlen(argv[2]);
+    char *temp_path = malloc(path_len + sizeof(".tmp"));
+    if (temp_path == NULL)
+    {
+        free(image);
+        return 1;
+    }
+    memcpy(temp_path, argv[2], path_len);
+    memcpy(temp_path + path_len, ".tmp", sizeof(".tmp"));
+
+    FILE *file = fopen(temp_path, "wb");
+    bool written = file != NULL && fwrite(image, 1, size, file) == size;
+    if (file != NULL && fclose(file) != 0)
+    {
+        written = false;
+    }
+
+    bool failed = !written || rename(temp_path, argv[2]) != 0;
+    if (failed)
+    {
+        fprintf(stderr, "kvc: could not write %s\n", argv[2]);
+        remove(temp_path);
+    }
+
+    free(temp_path);
+    free(image);
+    return failed ? 1 : 0;
+}
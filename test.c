@@ -8,12 +8,37 @@
  * MIT licensed
  *
  */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L /* utimensat() */
+#endif
 
 #include "kv_parse.h"
+#include "kv_parse_bloom.h"
 #include "kv_parse_buffer.h"
+#include "kv_parse_class.h"
+#include "kv_parse_index.h"
+#include "kv_parse_key.h"
+#include "kv_parse_kvc.h"
+#include "kv_parse_kvidx.h"
+#include "kv_parse_lines.h"
+#ifdef __linux__
+#include "kv_parse_live.h"
+#endif
+#include "kv_parse_map.h"
+#include "kv_parse_pread.h"
+#include "kv_parse_reader.h"
+#include "kv_parse_section.h"
+#include "kv_parse_stream.h"
+#include "kv_parse_typed.h"
 #include <assert.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 int kv_parse_buffer(char *input, const char *key, char *value, size_t value_max)
 {
@@ -41,6 +66,76 @@ int kv_parse(FILE *file, const char *key, char *value, size_t value_max)
     return 0;
 }
 
+int kv_parse_read(FILE *file, const char *key, char *value, size_t value_max)
+{
+    char block[32];
+    kv_parse_reader reader;
+    kv_parse_reader_init(&reader, file, block, sizeof(block));
+    kv_parse_reader_rewind(&reader);
+    for (size_t line = 0; kv_parse_reader_next_line(&reader, line); line++)
+    {
+        if (kv_parse_reader_check_key(&reader, key))
+        {
+            return kv_parse_reader_get_value(&reader, value, value_max);
+        }
+    }
+    return 0;
+}
+
+int kv_parse_span(const char *input, const char *end, const char *key, char *value, size_t value_max)
+{
+    for (size_t line = 0; (input = kv_parse_span_next_line(input, end, line)) != NULL; line++)
+    {
+        const char *input_value = NULL;
+        if ((input_value = kv_parse_span_check_key(input, end, key)) != NULL)
+        {
+            return kv_parse_span_get_value(input_value, end, value, value_max);
+        }
+    }
+    return 0;
+}
+
+int kv_parse_span_str(const char *input, const char *key, char *value, size_t value_max)
+{
+    return kv_parse_span(input, input + strlen(input), key, value, value_max);
+}
+
+int kv_parse_indexed(char *input, const char *key, char *value, size_t value_max)
+{
+    static unsigned char storage[KV_PARSE_INDEX_BYTES(64)];
+    kv_parse_index index;
+    kv_parse_index_init(&index, storage, 64);
+    kv_parse_buffer_index(&index, input);
+    return kv_parse_index_get(&index, key, value, value_max);
+}
+
+size_t kv_parse_streamed(const char *input, size_t split, char *output)
+{
+    char key[16];
+    char value[32];
+    char section[16];
+    kv_parse_stream stream;
+    kv_parse_stream_init(&stream, key, sizeof(key), value, sizeof(value), section, sizeof(section));
+
+    /* Feed the input in chunks of `split` bytes and log records as "section/key=value;" */
+    size_t len = strlen(input);
+    output[0] = '\0';
+    for (size_t pos = 0; pos < len;)
+    {
+        size_t chunk = (len - pos) < split ? (len - pos) : split;
+        pos += kv_parse_stream_feed(&stream, input + pos, chunk);
+        if (stream.ready)
+        {
+            sprintf(output + strlen(output), "%s/%s=%s;", stream.section, stream.key, stream.value);
+        }
+    }
+    if (kv_parse_stream_finish(&stream))
+    {
+        sprintf(output + strlen(output), "%s/%s=%s;", stream.section, stream.key, stream.value);
+    }
+    return stream.dropped;
+}
+
 // Test case function
 void run_kv_parse_buffer_tests()
 {
@@ -423,47 +518,3339 @@ void run_kv_parse_tests()
     printf("kv_parse() passed successfully!\n");
 }
 
-void run_kv_parse_buffer_check_section()
+void run_kv_parse_reader_tests()
 {
+    // **Test 1: Basic Key-Value Retrieval**
     {
-        // **Test 1: Basic Section Detection**
         char buffer[100] = {0};
-        int buffer_count = kv_parse_buffer_check_section("[section1]\n", buffer, sizeof(buffer));
-        assert(buffer_count == 8);
-        assert(strcmp(buffer, "section1") == 0);
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("key1=value1\nkey2=value2", temp);
+
+        buffer_count = kv_parse_read(temp, "key1", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 6);
+        assert(strcmp(buffer, "value1") == 0);
     }
 
-    printf("kv_parse_buffer_check_section() passed successfully!\n");
-}
+    // **Test 2: Retrieve Last Key**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
 
-void run_kv_parse_check_section()
-{
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("a=b\nc=d\ne=f\ng=hello", temp);
+
+        buffer_count = kv_parse_read(temp, "g", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 5);
+        assert(strcmp(buffer, "hello") == 0);
+    }
+
+    // **Test 3: Key Not Found**
     {
-        // **Test 1: Basic Section Detection**
         char buffer[100] = {0};
+        int buffer_count = 0;
 
         FILE *temp = tmpfile();
         assert(temp != NULL);
 
-        fputs("[section1]\n", temp);
-        rewind(temp);
+        fputs("a=b\nc=d", temp);
 
-        int buffer_count = kv_parse_check_section(temp, buffer, sizeof(buffer));
+        buffer_count = kv_parse_read(temp, "z", buffer, sizeof(buffer));
 
         fclose(temp);
-        assert(buffer_count == 8);
-        assert(strcmp(buffer, "section1") == 0);
+
+        assert(buffer_count == 0);
     }
 
-    printf("kv_parse_check_section() passed successfully!\n");
-}
+    // **Test 4: Buffer Too Small**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
 
-// Run tests in main()
-int main()
-{
-    run_kv_parse_buffer_tests();
-    run_kv_parse_tests();
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("longkey=longvalue", temp);
+
+        buffer_count = kv_parse_read(temp, "longkey", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 9);
+        assert(strcmp(buffer, "longvalue") == 0);
+    }
+
+    // **Test 5: Empty Input**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("", temp);
+
+        buffer_count = kv_parse_read(temp, "anykey", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 0);
+    }
+
+    // **Test 6: Input Without Key-Value Pairs**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("randomtext\nanotherline", temp);
+
+        buffer_count = kv_parse_read(temp, "key", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 0);
+    }
+
+    //  **Test 7: Handling Spaces Around Key and Value**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs(" key = value \n next = test ", temp);
+
+        buffer_count = kv_parse_read(temp, "key", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(buffer_count == 5);
+        assert(strcmp(buffer, "value") == 0);
+#else
+        assert(buffer_count == 0);
+#endif
+    }
+
+    // **Test 8: Duplicate Keys (Return First Occurrence)**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("x=1\nx=2\nx=3", temp);
+
+        buffer_count = kv_parse_read(temp, "x", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 1);
+        assert(strcmp(buffer, "1") == 0);
+    }
+
+    // **Test 9: Newline Variations (Windows vs. Unix)**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("a=one\r\nb=two", temp);
+
+        buffer_count = kv_parse_read(temp, "b", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 3);
+        assert(strcmp(buffer, "two") == 0);
+    }
+
+    // **Test 10: Key With Special Characters**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("user-name=admin\nuser@domain.com=me", temp);
+
+        buffer_count = kv_parse_read(temp, "user-name", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 5);
+        assert(strcmp(buffer, "admin") == 0);
+    }
+
+    // **Test 11: Value Containing '='**
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("path=/home/user=data", temp);
+
+        buffer_count = kv_parse_read(temp, "path", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+        assert(buffer_count == 15);
+        assert(strcmp(buffer, "/home/user=data") == 0);
+    }
+
+    // **Test 12: Quoted String **
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("path=\"/home/user=data\"", temp);
+
+        buffer_count = kv_parse_read(temp, "path", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(buffer_count == 15);
+        assert(strcmp(buffer, "/home/user=data") == 0);
+#else
+        assert(buffer_count == 17);
+        assert(strcmp(buffer, "\"/home/user=data\"") == 0);
+#endif
+    }
+
+    // **Test 13: Uncapped Quoted String **
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("path=\"/home/user=data", temp);
+
+        buffer_count = kv_parse_read(temp, "path", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(buffer_count == 15);
+        assert(strcmp(buffer, "/home/user=data") == 0);
+#else
+        assert(buffer_count == 16);
+        assert(strcmp(buffer, "\"/home/user=data") == 0);
+#endif
+    }
+
+    // **Test 14: Quoted String With Escaped Quote **
+    {
+        char buffer[100] = {0};
+        int buffer_count = 0;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("path=\"/home/\\\"user=data\"", temp);
+
+        buffer_count = kv_parse_read(temp, "path", buffer, sizeof(buffer));
+
+        fclose(temp);
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(buffer_count == 16);
+        assert(strcmp(buffer, "/home/\"user=data") == 0);
+#else
+        assert(buffer_count == 19);
+        assert(strcmp(buffer, "\"/home/\\\"user=data\"") == 0);
+#endif
+    }
+
+    // **Test 15: Refill Across Lines With A Tiny Block**
+    {
+        char buffer[100] = {0};
+        char block[8];
+        kv_parse_reader reader;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("aa=1\nbbbb=22\n\nc=333\nlong=skippedvalue\nd=4\n", temp);
+        rewind(temp);
+
+        kv_parse_reader_init(&reader, temp, block, sizeof(block));
+        size_t lines = 0;
+        for (size_t line = 0; kv_parse_reader_next_line(&reader, line); line++)
+        {
+            lines++;
+            if (kv_parse_reader_check_key(&reader, "c"))
+            {
+                assert(kv_parse_reader_get_value(&reader, buffer, sizeof(buffer)) == 3);
+                assert(strcmp(buffer, "333") == 0);
+            }
+            if (kv_parse_reader_check_key(&reader, "long"))
+            {
+                assert(kv_parse_reader_get_value(&reader, buffer, sizeof(buffer)) == 0);
+            }
+            if (kv_parse_reader_check_key(&reader, "d"))
+            {
+                assert(kv_parse_reader_get_value(&reader, buffer, sizeof(buffer)) == 1);
+                assert(strcmp(buffer, "4") == 0);
+            }
+        }
+
+        fclose(temp);
+
+        assert(lines == 6);
+    }
+
+    // **Test 16: Section Header**
+    {
+        char buffer[100] = {0};
+        char block[32];
+        kv_parse_reader reader;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("a=1\n[section1]\n", temp);
+
+        kv_parse_reader_init(&reader, temp, block, sizeof(block));
+        kv_parse_reader_rewind(&reader);
+        assert(kv_parse_reader_next_line(&reader, 0));
+        assert(kv_parse_reader_check_section(&reader, buffer, sizeof(buffer)) == 0);
+        assert(kv_parse_reader_next_line(&reader, 1));
+        assert(kv_parse_reader_check_section(&reader, buffer, sizeof(buffer)) == 8);
+        assert(strcmp(buffer, "section1") == 0);
+        assert(!kv_parse_reader_next_line(&reader, 2));
+
+        fclose(temp);
+    }
+
+    printf("kv_parse_reader() passed successfully!\n");
+}
+
+void run_kv_parse_index_tests()
+{
+    char buffer[100] = {0};
+    int buffer_count = 0;
+
+    // **Test 1: Basic Key-Value Retrieval**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("key1=value1\nkey2=value2", "key1", buffer, sizeof(buffer));
+    assert(buffer_count == 6);
+    assert(strcmp(buffer, "value1") == 0);
+
+    // **Test 2: Retrieve Last Key**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("a=b\nc=d\ne=f\ng=hello", "g", buffer, sizeof(buffer));
+    assert(buffer_count == 5);
+    assert(strcmp(buffer, "hello") == 0);
+
+    // **Test 3: Key Not Found**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("a=b\nc=d", "z", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    // **Test 4: Buffer Too Small**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("longkey=longvalue", "longkey", buffer, sizeof(buffer));
+    assert(buffer_count == 9);
+    assert(strcmp(buffer, "longvalue") == 0);
+
+    // **Test 5: Empty Input**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("", "anykey", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    // **Test 6: Input Without Key-Value Pairs**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("randomtext\nanotherline", "key", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    //  **Test 7: Handling Spaces Around Key and Value**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed(" key = value \n next = test ", "key", buffer, sizeof(buffer));
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    assert(buffer_count == 5);
+    assert(strcmp(buffer, "value") == 0);
+#else
+    assert(buffer_count == 0);
+#endif
+
+    // **Test 8: Duplicate Keys (Return First Occurrence)**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("x=1\nx=2\nx=3", "x", buffer, sizeof(buffer));
+    assert(buffer_count == 1);
+    assert(strcmp(buffer, "1") == 0);
+
+    // **Test 9: Newline Variations (Windows vs. Unix)**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("a=one\r\nb=two", "b", buffer, sizeof(buffer));
+    assert(buffer_count == 3);
+    assert(strcmp(buffer, "two") == 0);
+
+    // **Test 10: Key With Special Characters**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("user-name=admin\nuser@domain.com=me", "user-name", buffer, sizeof(buffer));
+    assert(buffer_count == 5);
+    assert(strcmp(buffer, "admin") == 0);
+
+    // **Test 11: Value Containing '='**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("path=/home/user=data", "path", buffer, sizeof(buffer));
+    assert(buffer_count == 15);
+    assert(strcmp(buffer, "/home/user=data") == 0);
+
+    // **Test 12: Quoted String **
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("path=\"/home/user=data\"", "path", buffer, sizeof(buffer));
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    assert(buffer_count == 15);
+    assert(strcmp(buffer, "/home/user=data") == 0);
+#else
+    assert(buffer_count == 17);
+    assert(strcmp(buffer, "\"/home/user=data\"") == 0);
+#endif
+
+    // **Test 13: Uncapped Quoted String **
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("path=\"/home/user=data", "path", buffer, sizeof(buffer));
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    assert(buffer_count == 15);
+    assert(strcmp(buffer, "/home/user=data") == 0);
+#else
+    assert(buffer_count == 16);
+    assert(strcmp(buffer, "\"/home/user=data") == 0);
+#endif
+
+    // **Test 14: Quoted String With Escaped Quote **
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_indexed("path=\"/home/\\\"user=data\"", "path", buffer, sizeof(buffer));
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    assert(buffer_count == 16);
+    assert(strcmp(buffer, "/home/\"user=data") == 0);
+#else
+    assert(buffer_count == 19);
+    assert(strcmp(buffer, "\"/home/\\\"user=data\"") == 0);
+#endif
+
+    // **Test 15: Duplicate Keys Across Sections (Return First Occurrence)**
+    {
+        static unsigned char storage[KV_PARSE_INDEX_BYTES(8)];
+        kv_parse_index index;
+        kv_parse_index_init(&index, storage, 8);
+        char input[] = "[a]\nx=1\n[b]\nx=2\ny=3";
+        assert(kv_parse_buffer_index(&index, input));
+        assert(index.count == 3);
+        assert(index.section_id[0] == 1);
+        assert(index.section_id[2] == 2);
+        memset(buffer, 0, sizeof(buffer));
+        buffer_count = kv_parse_index_get(&index, "x", buffer, sizeof(buffer));
+        assert(buffer_count == 1);
+        assert(strcmp(buffer, "1") == 0);
+        buffer_count = kv_parse_index_get(&index, "y", buffer, sizeof(buffer));
+        assert(buffer_count == 1);
+        assert(strcmp(buffer, "3") == 0);
+    }
+
+    // **Test 16: Many Keys Probing Across Groups**
+    {
+        static unsigned char storage[KV_PARSE_INDEX_BYTES(500)];
+        static char input[500 * 16];
+        kv_parse_index index;
+        kv_parse_index_init(&index, storage, 500);
+        char *pos = input;
+        for (int i = 0; i < 500; i++)
+        {
+            pos += sprintf(pos, "k%d=v%d\n", i, i * 3);
+        }
+        assert(kv_parse_buffer_index(&index, input));
+        assert(index.count == 500);
+        for (int i = 0; i < 500; i++)
+        {
+            char key[16];
+            char expected[16];
+            sprintf(key, "k%d", i);
+            sprintf(expected, "v%d", i * 3);
+            buffer_count = kv_parse_index_get(&index, key, buffer, sizeof(buffer));
+            assert(buffer_count == (int)strlen(expected));
+            assert(strcmp(buffer, expected) == 0);
+        }
+        assert(kv_parse_index_get(&index, "k500", buffer, sizeof(buffer)) == 0);
+        assert(kv_parse_index_get(&index, "k", buffer, sizeof(buffer)) == 0);
+    }
+
+    // **Test 17: Index Capacity Exceeded**
+    {
+        static unsigned char storage[KV_PARSE_INDEX_BYTES(2)];
+        kv_parse_index index;
+        kv_parse_index_init(&index, storage, 2);
+        char input[] = "a=1\nb=2\nc=3";
+        assert(!kv_parse_buffer_index(&index, input));
+        assert(index.count == 2);
+        buffer_count = kv_parse_index_get(&index, "b", buffer, sizeof(buffer));
+        assert(buffer_count == 1);
+        assert(strcmp(buffer, "2") == 0);
+    }
+
+    // **Test 18: Keys Split At The First Delimiter, Unlike check_key**
+    {
+        static unsigned char storage[KV_PARSE_INDEX_BYTES(4)];
+        kv_parse_index index;
+        kv_parse_index_init(&index, storage, 4);
+        char input[] = "db:host=localhost\nname = x\n";
+        assert(kv_parse_buffer_index(&index, input));
+        assert(index.count == 2);
+
+        // "db" holds "host=localhost", so "db:host" is only found by a linear check_key scan
+        assert(kv_parse_buffer_check_key(input, "db:host") != NULL);
+        assert(kv_parse_index_get(&index, "db:host", buffer, sizeof(buffer)) == 0);
+        buffer_count = kv_parse_index_get(&index, "db", buffer, sizeof(buffer));
+        assert(buffer_count == 14);
+        assert(strcmp(buffer, "host=localhost") == 0);
+
+        // Whitespace before the delimiter is trimmed off the indexed key
+        assert(kv_parse_buffer_check_key(kv_parse_buffer_next_line(input, 1), "name ") != NULL);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(kv_parse_index_get(&index, "name ", buffer, sizeof(buffer)) == 0);
+        assert(kv_parse_index_get(&index, "name", buffer, sizeof(buffer)) == 1);
+#else
+        assert(kv_parse_index_get(&index, "name ", buffer, sizeof(buffer)) == 2);
+#endif
+    }
+
+    printf("kv_parse_index_get() passed successfully!\n");
+}
+
+void run_kv_parse_buffer_get_many_tests()
+{
+    // **Test 1: Many Keys In One Pass (Return First Occurrence)**
+    {
+        char b[100] = {0};
+        char c[100] = {0};
+        char z[100] = {0};
+        char b2[100] = {0};
+        kv_parse_buffer_query queries[] = {
+            {"b", b, sizeof(b)},
+            {"c", c, sizeof(c)},
+            {"z", z, sizeof(z)},
+            {"b", b2, sizeof(b2)},
+        };
+        size_t found = kv_parse_buffer_get_many("a=1\nbb=x\nb=2\nc = 3 \nb=4", queries, 4);
+        assert(queries[0].found && queries[0].value_len == 1 && strcmp(b, "2") == 0);
+        assert(queries[2].found == false);
+        assert(queries[3].found && queries[3].value_len == 1 && strcmp(b2, "2") == 0);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(found == 3);
+        assert(queries[1].found && queries[1].value_len == 1 && strcmp(c, "3") == 0);
+#else
+        assert(found == 2);
+        assert(queries[1].found == false);
+#endif
+    }
+
+    // **Test 2: Quoted Value**
+    {
+        char path[100] = {0};
+        kv_parse_buffer_query queries[] = {
+            {"path", path, sizeof(path)},
+        };
+        size_t found = kv_parse_buffer_get_many("x=1\npath=\"/home/user=data\"", queries, 1);
+        assert(found == 1);
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(queries[0].value_len == 15);
+        assert(strcmp(path, "/home/user=data") == 0);
+#else
+        assert(queries[0].value_len == 17);
+        assert(strcmp(path, "\"/home/user=data\"") == 0);
+#endif
+    }
+
+    printf("kv_parse_buffer_get_many() passed successfully!\n");
+}
+
+void run_kv_parse_get_many_tests()
+{
+    // **Test 1: Many Keys In One Pass (Return First Occurrence)**
+    {
+        char b[100] = {0};
+        char c[100] = {0};
+        char z[100] = {0};
+        char b2[100] = {0};
+        kv_parse_query queries[] = {
+            {"b", b, sizeof(b)},
+            {"c", c, sizeof(c)},
+            {"z", z, sizeof(z)},
+            {"b", b2, sizeof(b2)},
+        };
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("a=1\n\nbb=x\nb=2\nc = 3 \nb=4", temp);
+
+        size_t found = kv_parse_get_many(temp, queries, 4);
+
+        fclose(temp);
+
+        assert(queries[0].found && queries[0].value_len == 1 && strcmp(b, "2") == 0);
+        assert(queries[2].found == false);
+        assert(queries[3].found && queries[3].value_len == 1 && strcmp(b2, "2") == 0);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(found == 3);
+        assert(queries[1].found && queries[1].value_len == 1 && strcmp(c, "3") == 0);
+#else
+        assert(found == 2);
+        assert(queries[1].found == false);
+#endif
+    }
+
+    // **Test 2: Quoted Value**
+    {
+        char path[100] = {0};
+        kv_parse_query queries[] = {
+            {"path", path, sizeof(path)},
+        };
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("x=1\npath=\"/home/user=data\"", temp);
+
+        size_t found = kv_parse_get_many(temp, queries, 1);
+
+        fclose(temp);
+
+        assert(found == 1);
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(queries[0].value_len == 15);
+        assert(strcmp(path, "/home/user=data") == 0);
+#else
+        assert(queries[0].value_len == 17);
+        assert(strcmp(path, "\"/home/user=data\"") == 0);
+#endif
+    }
+
+    // **Test 3: Value Holding A Delimiter Is Not Read As A Key**
+    {
+        char url[100] = {0};
+        char host[100] = {0};
+        char port[100] = {0};
+        kv_parse_query queries[] = {
+            {"url", url, sizeof(url)},
+            {"host", host, sizeof(host)},
+            {"port", port, sizeof(port)},
+        };
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("url=host:8080\nport=1\n", temp);
+
+        size_t found = kv_parse_get_many(temp, queries, 3);
+
+        fclose(temp);
+
+        assert(found == 2);
+        assert(queries[0].found && strcmp(url, "host:8080") == 0);
+        assert(queries[1].found == false && host[0] == '\0');
+        assert(queries[2].found && strcmp(port, "1") == 0);
+    }
+
+    printf("kv_parse_get_many() passed successfully!\n");
+}
+
+void run_kv_parse_span_tests()
+{
+    char buffer[100] = {0};
+    int buffer_count = 0;
+
+    // **Test 1: Basic Key-Value Retrieval**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("key1=value1\nkey2=value2", "key1", buffer, sizeof(buffer));
+    assert(buffer_count == 6);
+    assert(strcmp(buffer, "value1") == 0);
+
+    // **Test 2: Retrieve Last Key**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("a=b\nc=d\ne=f\ng=hello", "g", buffer, sizeof(buffer));
+    assert(buffer_count == 5);
+    assert(strcmp(buffer, "hello") == 0);
+
+    // **Test 3: Key Not Found**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("a=b\nc=d", "z", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    // **Test 4: Buffer Too Small**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("longkey=longvalue", "longkey", buffer, sizeof(buffer));
+    assert(buffer_count == 9);
+    assert(strcmp(buffer, "longvalue") == 0);
+
+    // **Test 5: Empty Input**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("", "anykey", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    // **Test 6: Input Without Key-Value Pairs**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("randomtext\nanotherline", "key", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    //  **Test 7: Handling Spaces Around Key and Value**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str(" key = value \n next = test ", "key", buffer, sizeof(buffer));
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    assert(buffer_count == 5);
+    assert(strcmp(buffer, "value") == 0);
+#else
+    assert(buffer_count == 0);
+#endif
+
+    // **Test 8: Duplicate Keys (Return First Occurrence)**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("x=1\nx=2\nx=3", "x", buffer, sizeof(buffer));
+    assert(buffer_count == 1);
+    assert(strcmp(buffer, "1") == 0);
+
+    // **Test 9: Newline Variations (Windows vs. Unix)**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("a=one\r\nb=two", "b", buffer, sizeof(buffer));
+    assert(buffer_count == 3);
+    assert(strcmp(buffer, "two") == 0);
+
+    // **Test 10: Key With Special Characters**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("user-name=admin\nuser@domain.com=me", "user-name", buffer, sizeof(buffer));
+    assert(buffer_count == 5);
+    assert(strcmp(buffer, "admin") == 0);
+
+    // **Test 11: Value Containing '='**
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("path=/home/user=data", "path", buffer, sizeof(buffer));
+    assert(buffer_count == 15);
+    assert(strcmp(buffer, "/home/user=data") == 0);
+
+    // **Test 12: Quoted String **
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("path=\"/home/user=data\"", "path", buffer, sizeof(buffer));
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    assert(buffer_count == 15);
+    assert(strcmp(buffer, "/home/user=data") == 0);
+#else
+    assert(buffer_count == 17);
+    assert(strcmp(buffer, "\"/home/user=data\"") == 0);
+#endif
+
+    // **Test 13: Uncapped Quoted String **
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("path=\"/home/user=data", "path", buffer, sizeof(buffer));
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    assert(buffer_count == 15);
+    assert(strcmp(buffer, "/home/user=data") == 0);
+#else
+    assert(buffer_count == 16);
+    assert(strcmp(buffer, "\"/home/user=data") == 0);
+#endif
+
+    // **Test 14: Quoted String With Escaped Quote **
+    memset(buffer, 0, sizeof(buffer));
+    buffer_count = kv_parse_span_str("path=\"/home/\\\"user=data\"", "path", buffer, sizeof(buffer));
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    assert(buffer_count == 16);
+    assert(strcmp(buffer, "/home/\"user=data") == 0);
+#else
+    assert(buffer_count == 19);
+    assert(strcmp(buffer, "\"/home/\\\"user=data\"") == 0);
+#endif
+
+    // **Test 15: Read Only Slice Without Null Terminator**
+    {
+        static const char input[] = "skip=0\nkey1=value1key2=value2\nkey3=x";
+        const char *begin = input + 7;
+        const char *end = begin + 11;
+        memset(buffer, 0, sizeof(buffer));
+        buffer_count = kv_parse_span(begin, end, "key1", buffer, sizeof(buffer));
+        assert(buffer_count == 6);
+        assert(strcmp(buffer, "value1") == 0);
+        buffer_count = kv_parse_span(begin, end, "key3", buffer, sizeof(buffer));
+        assert(buffer_count == 0);
+        buffer_count = kv_parse_span(begin, begin + 3, "key1", buffer, sizeof(buffer));
+        assert(buffer_count == 0);
+    }
+
+    // **Test 16: Embedded Null Is Data**
+    {
+        static const char input[] = {'a', '=', '1', '\0', '2', '\n', 'b', '=', '3'};
+        memset(buffer, 0, sizeof(buffer));
+        buffer_count = kv_parse_span(input, input + sizeof(input), "b", buffer, sizeof(buffer));
+        assert(buffer_count == 1);
+        assert(strcmp(buffer, "3") == 0);
+        buffer_count = kv_parse_span(input, input + sizeof(input), "a", buffer, sizeof(buffer));
+        assert(buffer_count == 3);
+        assert(memcmp(buffer, "1\0" "2", 3) == 0);
+    }
+
+    // **Test 17: Buffer Size Limits**
+    {
+        static const char input[] = "value\n";
+        const char *end = input + strlen(input);
+        assert(kv_parse_span_get_value(input, end, buffer, 1) == 0);
+        assert(kv_parse_span_get_value(input, end, buffer, 6) == 0);
+        assert(kv_parse_span_get_value(input, end, buffer, 7) == 5);
+        assert(kv_parse_span_get_value(input, end, buffer, SIZE_MAX) == 5);
+        assert(strcmp(buffer, "value") == 0);
+    }
+
+    printf("kv_parse_span() passed successfully!\n");
+}
+
+void run_kv_parse_buffer_scan_tests()
+{
+    // **Test 1: Scans At Every Alignment And Length Match A Byte Loop**
+    static char buffer[256];
+    for (size_t offset = 0; offset < 64; offset++)
+    {
+        for (size_t length = 0; length < 100; length++)
+        {
+            char *str = buffer + offset;
+            memset(buffer, 'x', sizeof(buffer));
+            memset(str, ' ', length);
+            str[length] = '\0';
+
+            assert(kv_parse_buffer_scan_line(str) == str + length);
+            assert(kv_parse_buffer_scan_delimiter(str) == str + length);
+            assert(kv_parse_buffer_skip_whitespace(str) == str + length);
+
+            if (length > 0)
+            {
+                str[length - 1] = '\t';
+                str[length / 2] = 'k';
+                assert(kv_parse_buffer_skip_whitespace(str) == str + length / 2);
+
+                str[length - 1] = '\n';
+                assert(kv_parse_buffer_scan_line(str) == str + length - 1);
+
+                str[length / 3] = ':';
+                assert(kv_parse_buffer_scan_delimiter(str) == str + length / 3);
+            }
+        }
+    }
+
+    printf("kv_parse_buffer_scan_line() passed successfully!\n");
+}
+
+void *kv_parse_map_test_write(void *arg)
+{
+    FILE *fifo = fopen((const char *)arg, "w");
+    assert(fifo != NULL);
+    fputs("a=1\nbb=2\nc=3\n", fifo);
+    fclose(fifo);
+    return NULL;
+}
+
+void run_kv_parse_map_tests()
+{
+    // **Test 1: Mapped File Lookup**
+    {
+        char buffer[100] = {0};
+        kv_parse_map map;
+
+        FILE *temp = fopen("kv_parse_map_test.env", "w");
+        assert(temp != NULL);
+        fputs("a=one\r\nb=two\nx=1\nx=2", temp);
+        fclose(temp);
+
+        assert(kv_parse_map_open(&map, "kv_parse_map_test.env"));
+        assert(map.data != NULL && map.map_size == map.size);
+        assert(kv_parse_map_get(&map, "b", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "two") == 0);
+        assert(kv_parse_map_get(&map, "x", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "1") == 0);
+        assert(kv_parse_map_get(&map, "z", buffer, sizeof(buffer)) == 0);
+        assert(strcmp(buffer, "") == 0);
+        kv_parse_map_close(&map);
+
+        remove("kv_parse_map_test.env");
+    }
+
+    // **Test 2: Empty File**
+    {
+        char buffer[100] = {0};
+        kv_parse_map map;
+
+        FILE *temp = fopen("kv_parse_map_test.env", "w");
+        assert(temp != NULL);
+        fclose(temp);
+
+        assert(kv_parse_map_open(&map, "kv_parse_map_test.env"));
+        assert(kv_parse_map_get(&map, "a", buffer, sizeof(buffer)) == 0);
+        kv_parse_map_close(&map);
+
+        remove("kv_parse_map_test.env");
+    }
+
+    // **Test 3: Missing File**
+    {
+        kv_parse_map map;
+        assert(!kv_parse_map_open(&map, "kv_parse_map_test.missing"));
+    }
+
+    // **Test 4: Non Regular File Is Read Into Memory**
+    {
+        char buffer[100] = {0};
+        kv_parse_map map;
+
+        assert(kv_parse_map_open(&map, "/dev/null"));
+        assert(map.data != NULL && map.size == 0);
+        assert(kv_parse_map_get(&map, "a", buffer, sizeof(buffer)) == 0);
+        kv_parse_map_close(&map);
+    }
+
+    // **Test 5: FIFO Data Is Read From The Opened Descriptor**
+    {
+        char buffer[100] = {0};
+        kv_parse_map map;
+        pthread_t writer;
+
+        remove("kv_parse_map_test.fifo");
+        assert(mkfifo("kv_parse_map_test.fifo", 0600) == 0);
+        assert(pthread_create(&writer, NULL, kv_parse_map_test_write, "kv_parse_map_test.fifo") == 0);
+
+        assert(kv_parse_map_open(&map, "kv_parse_map_test.fifo"));
+        assert(map.size == 13);
+        assert(kv_parse_map_get(&map, "c", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "3") == 0);
+
+        // Every lookup sees the whole stream, and a miss clears the value
+        assert(kv_parse_map_get(&map, "a", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "1") == 0);
+        assert(kv_parse_map_get(&map, "bb", buffer, sizeof(buffer)) == 1);
+        assert(kv_parse_map_get(&map, "b", buffer, sizeof(buffer)) == 0);
+        assert(strcmp(buffer, "") == 0);
+        kv_parse_map_close(&map);
+
+        pthread_join(writer, NULL);
+        remove("kv_parse_map_test.fifo");
+    }
+
+    printf("kv_parse_map_get() passed successfully!\n");
+}
+
+void run_kv_parse_buffer_get_value_view_tests()
+{
+    // **Test 1: View Decodes To The Same Value As A Copy**
+    {
+        static const char *inputs[] = {
+            "value1",
+            " value \n next = test ",
+            "one\r\nb=two",
+            "/home/user=data",
+            "\"/home/user=data\"",
+            "\"/home/user=data",
+            "\"/home/\\\"user=data\"",
+            "  'quoted value'  trailing",
+            "abc\"def\"ghi",
+            "\"a\\\"\"",
+            "",
+        };
+
+        for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+        {
+            char expected[100] = {0};
+            char buffer[100] = {0};
+            char input[100] = {0};
+            strcpy(input, inputs[i]);
+            size_t expected_count = kv_parse_buffer_get_value(input, expected, sizeof(expected));
+            kv_parse_view view = kv_parse_buffer_get_value_view(input);
+            assert(view.ptr >= input && view.ptr + view.len <= input + strlen(input));
+            assert(kv_parse_view_unescape(view, buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+    }
+
+    // **Test 2: Plain View Points Into Input**
+    {
+        static const char input[] = "  value  \r\nnext=x";
+        kv_parse_view view = kv_parse_buffer_get_value_view(input);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(view.ptr == input + 2 && view.len == 5);
+#else
+        assert(view.ptr == input && view.len == 9);
+#endif
+        assert(view.flags == 0);
+    }
+
+    // **Test 3: Quotes Stripped By Span Adjustment**
+    {
+        static const char input[] = "\"/home/user=data\"";
+        kv_parse_view view = kv_parse_buffer_get_value_view(input);
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(view.ptr == input + 1 && view.len == 15);
+        assert(view.flags == KV_PARSE_VIEW_QUOTED);
+#else
+        assert(view.ptr == input && view.len == 17);
+        assert(view.flags == 0);
+#endif
+    }
+
+    // **Test 4: Escapes Flagged**
+    {
+        static const char input[] = "\"/home/\\\"user=data\"";
+        kv_parse_view view = kv_parse_buffer_get_value_view(input);
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        char buffer[100] = {0};
+        assert(view.flags == (KV_PARSE_VIEW_QUOTED | KV_PARSE_VIEW_ESCAPED));
+        assert(kv_parse_view_unescape(view, buffer, sizeof(buffer)) == 16);
+        assert(strcmp(buffer, "/home/\"user=data") == 0);
+#else
+        assert(view.flags == 0);
+#endif
+    }
+
+    // **Test 5: Value Too Large For Buffer**
+    {
+        static const char input[] = "longvalue";
+        char buffer[4] = {0};
+        kv_parse_view view = kv_parse_buffer_get_value_view(input);
+        assert(view.len == 9);
+        assert(kv_parse_view_unescape(view, buffer, sizeof(buffer)) == 0);
+    }
+
+    // **Test 6: Index View**
+    {
+        static unsigned char storage[KV_PARSE_INDEX_BYTES(4)];
+        kv_parse_index index;
+        kv_parse_index_init(&index, storage, 4);
+        char input[] = "a=1\nkey = 'value' \nb=2";
+        kv_parse_buffer_index(&index, input);
+        kv_parse_view view = kv_parse_index_get_view(&index, "b");
+        assert(view.ptr == input + 21 && view.len == 1);
+        view = kv_parse_index_get_view(&index, "missing");
+        assert(view.ptr == NULL && view.len == 0);
+#if !defined(KV_PARSE_DISABLE_WHITESPACE_SKIP) && !defined(KV_PARSE_DISABLE_QUOTED_STRINGS)
+        view = kv_parse_index_get_view(&index, "key");
+        assert(view.ptr == input + 11 && view.len == 5);
+        assert(view.flags == KV_PARSE_VIEW_QUOTED);
+#endif
+    }
+
+    printf("kv_parse_buffer_get_value_view() passed successfully!\n");
+}
+
+void run_kv_parse_stream_tests()
+{
+    // **Test 1: Records Match Buffer Parser**
+    {
+        static const char input[] = "key1=value1\n key2 = value2 \nnokey\nkey3=\"quoted value\" trailing\n";
+        char output[256] = {0};
+        assert(kv_parse_streamed(input, sizeof(input), output) == 0);
+#if !defined(KV_PARSE_DISABLE_WHITESPACE_SKIP) && !defined(KV_PARSE_DISABLE_QUOTED_STRINGS)
+        assert(strcmp(output, "/key1=value1;/key2=value2;/key3=quoted value;") == 0);
+#elif !defined(KV_PARSE_DISABLE_WHITESPACE_SKIP)
+        assert(strcmp(output, "/key1=value1;/key2=value2;/key3=\"quoted value\" trailing;") == 0);
+#elif !defined(KV_PARSE_DISABLE_QUOTED_STRINGS)
+        assert(strcmp(output, "/key1=value1;/ key2 = value2 ;/key3=quoted value;") == 0);
+#else
+        assert(strcmp(output, "/key1=value1;/ key2 = value2 ;/key3=\"quoted value\" trailing;") == 0);
+#endif
+
+        char buffer[100] = {0};
+        char copy[sizeof(input)];
+        strcpy(copy, input);
+        assert(kv_parse_buffer(copy, "key3", buffer, sizeof(buffer)) > 0);
+        assert(strstr(output, buffer) != NULL);
+    }
+
+    // **Test 2: Any Chunk Size Gives The Same Records**
+    {
+        static const char input[] = "[sect]\r\nkey='a \\' b'\r\nx:y\r\n[other] \nlast=end";
+        char expected[256] = {0};
+        char output[256] = {0};
+        kv_parse_streamed(input, sizeof(input), expected);
+        for (size_t split = 1; split < sizeof(input); split++)
+        {
+            kv_parse_streamed(input, split, output);
+            assert(strcmp(output, expected) == 0);
+        }
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(strcmp(expected, "sect/key=a ' b;sect/x=y;other/last=end;") == 0);
+#else
+        assert(strcmp(expected, "sect/key='a \\' b';sect/x=y;other/last=end;") == 0);
+#endif
+    }
+
+    // **Test 3: Chunk Boundary At Every Byte**
+    {
+        static const char input[] = "alpha = \"one two\"\r\nbeta=2\r\n";
+        char expected[256] = {0};
+        char output[256] = {0};
+        char chunked[sizeof(input)];
+        kv_parse_streamed(input, sizeof(input), expected);
+        for (size_t cut = 1; cut < sizeof(input) - 1; cut++)
+        {
+            /* Two chunks, the first ending at `cut` */
+            char key[16];
+            char value[32];
+            kv_parse_stream stream;
+            kv_parse_stream_init(&stream, key, sizeof(key), value, sizeof(value), NULL, 0);
+            output[0] = '\0';
+            memcpy(chunked, input, sizeof(input));
+            for (size_t pos = 0; pos < sizeof(input) - 1;)
+            {
+                size_t end = pos < cut ? cut : sizeof(input) - 1;
+                pos += kv_parse_stream_feed(&stream, chunked + pos, end - pos);
+                if (stream.ready)
+                {
+                    sprintf(output + strlen(output), "/%s=%s;", stream.key, stream.value);
+                }
+            }
+            assert(!kv_parse_stream_finish(&stream));
+            assert(strcmp(output, expected) == 0);
+        }
+    }
+
+    // **Test 4: Oversized Records Are Dropped**
+    {
+        static const char input[] = "averyveryverylongkey=1\nk=averyveryveryveryveryverylongvalue\nok=yes\n";
+        char output[256] = {0};
+        assert(kv_parse_streamed(input, 5, output) == 2);
+        assert(strcmp(output, "/ok=yes;") == 0);
+    }
+
+    // **Test 5: Last Line Without Newline**
+    {
+        char output[256] = {0};
+        kv_parse_streamed("a=1\nb=2", 3, output);
+        assert(strcmp(output, "/a=1;/b=2;") == 0);
+        kv_parse_streamed("a=1\n[tail]", 3, output);
+        assert(strcmp(output, "/a=1;") == 0);
+        kv_parse_streamed("", 3, output);
+        assert(strcmp(output, "") == 0);
+    }
+
+    // **Test 6: Line Numbers And Reuse After Finish**
+    {
+        static const char input[] = "# comment\n\nkey=value\n";
+        char key[16];
+        char value[32];
+        kv_parse_stream stream;
+        kv_parse_stream_init(&stream, key, sizeof(key), value, sizeof(value), NULL, 0);
+        for (int pass = 0; pass < 2; pass++)
+        {
+            size_t used = kv_parse_stream_feed(&stream, input, sizeof(input) - 1);
+            assert(stream.ready);
+            assert(stream.line == 2);
+            assert(strcmp(stream.key, "key") == 0 && stream.key_len == 3);
+            assert(strcmp(stream.value, "value") == 0 && stream.value_len == 5);
+            kv_parse_stream_feed(&stream, input + used, sizeof(input) - 1 - used);
+            assert(!stream.ready);
+            assert(!kv_parse_stream_finish(&stream));
+        }
+    }
+
+    // **Test 7: Malformed Section Clears Section**
+    {
+        char output[256] = {0};
+        kv_parse_streamed("[a]\nx=1\n[b\ny=2\n", 4, output);
+        assert(strcmp(output, "a/x=1;/y=2;") == 0);
+    }
+
+    printf("kv_parse_stream() passed successfully!\n");
+}
+
+void run_kv_parse_buffer_iter_tests()
+{
+    // **Test 1: Records In Order With Sections**
+    {
+        static const char input[] = "top=1\n[db]\r\nhost = \"local host\"\r\n# comment\nport:5432\n[ cache ]  \n\nsize=64";
+        kv_parse_buffer_iter it;
+        kv_parse_record rec;
+        char value[32] = {0};
+        kv_parse_buffer_iter_init(&it, input);
+
+        assert(kv_parse_buffer_iter_next(&it, &rec));
+        assert(rec.section_len == 0 && rec.section_id == 0 && rec.line == 0);
+        assert(rec.key_len == 3 && strncmp(rec.key, "top", 3) == 0);
+        assert(rec.value.len == 1 && rec.value.ptr[0] == '1');
+
+        assert(kv_parse_buffer_iter_next(&it, &rec));
+        assert(rec.section_len == 2 && strncmp(rec.section, "db", 2) == 0 && rec.section_id == 1 && rec.line == 2);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(rec.key_len == 4 && strncmp(rec.key, "host", 4) == 0);
+#else
+        assert(rec.key_len == 5 && strncmp(rec.key, "host ", 5) == 0);
+#endif
+        kv_parse_view_unescape(rec.value, value, sizeof(value));
+#if !defined(KV_PARSE_DISABLE_WHITESPACE_SKIP) && !defined(KV_PARSE_DISABLE_QUOTED_STRINGS)
+        assert(strcmp(value, "local host") == 0);
+#elif !defined(KV_PARSE_DISABLE_WHITESPACE_SKIP)
+        assert(strcmp(value, "\"local host\"") == 0);
+#elif !defined(KV_PARSE_DISABLE_QUOTED_STRINGS)
+        assert(strcmp(value, " local host") == 0);
+#else
+        assert(strcmp(value, " \"local host\"") == 0);
+#endif
+
+        assert(kv_parse_buffer_iter_next(&it, &rec));
+        assert(rec.key_len == 4 && strncmp(rec.key, "port", 4) == 0 && rec.line == 4);
+        assert(rec.value.len == 4 && strncmp(rec.value.ptr, "5432", 4) == 0);
+
+        assert(kv_parse_buffer_iter_next(&it, &rec));
+        assert(rec.section_len == 7 && strncmp(rec.section, " cache ", 7) == 0 && rec.section_id == 2);
+        assert(rec.key_len == 4 && strncmp(rec.key, "size", 4) == 0 && rec.line == 7);
+        assert(rec.value.len == 2 && strncmp(rec.value.ptr, "64", 2) == 0);
+
+        assert(!kv_parse_buffer_iter_next(&it, &rec));
+        assert(!kv_parse_buffer_iter_next(&it, &rec));
+    }
+
+    // **Test 2: Values Match Key Lookup**
+    {
+        static const char input[] = "key1=value1\nkey2 = 'a \\' b' x\nbad line\nkey3=\"/home/user=data\"\n key4 :  spaced  \r\n";
+        kv_parse_buffer_iter it;
+        kv_parse_record rec;
+        size_t count = 0;
+        kv_parse_buffer_iter_init(&it, input);
+        while (kv_parse_buffer_iter_next(&it, &rec))
+        {
+            char key[32] = {0};
+            char expected[64] = {0};
+            char value[64] = {0};
+            char copy[sizeof(input)];
+            memcpy(key, rec.key, rec.key_len);
+            strcpy(copy, input);
+            size_t expected_len = kv_parse_buffer(copy, key, expected, sizeof(expected));
+            assert(kv_parse_view_unescape(rec.value, value, sizeof(value)) == expected_len);
+            assert(strcmp(value, expected) == 0);
+            count++;
+        }
+        assert(count == 4);
+    }
+
+    // **Test 3: Empty And Unterminated Section**
+    {
+        kv_parse_buffer_iter it;
+        kv_parse_record rec;
+        kv_parse_buffer_iter_init(&it, "");
+        assert(!kv_parse_buffer_iter_next(&it, &rec));
+
+        kv_parse_buffer_iter_init(&it, "[open\n[b=1\n\n");
+        assert(kv_parse_buffer_iter_next(&it, &rec));
+        assert(rec.section_id == 0 && rec.line == 1);
+        assert(rec.key_len == 2 && strncmp(rec.key, "[b", 2) == 0);
+        assert(!kv_parse_buffer_iter_next(&it, &rec));
+    }
+
+    printf("kv_parse_buffer_iter_next() passed successfully!\n");
+}
+
+void run_kv_parse_buffer_section_get_tests()
+{
+    static const char input[] = "host=global\n[db]\nhost = dbhost\nport=5432\n[cache] \r\nhost=cachehost\r\n[notheader\n[db]\nuser=admin\nhost=second\n";
+    kv_parse_section storage[8];
+    kv_parse_sections dir;
+    kv_parse_sections_init(&dir, storage, 8);
+
+    // **Test 1: Section Ranges And Interned Ids**
+    {
+        assert(kv_parse_buffer_sections(&dir, input));
+        assert(dir.count == 4);
+        assert(dir.names == 3);
+        assert(storage[0].id == 0 && storage[0].start == input && storage[0].end == input + 12);
+        assert(storage[1].id == 1 && storage[1].name_len == 2 && strncmp(storage[1].name, "db", 2) == 0);
+        assert(storage[2].id == 2 && storage[2].name_len == 5 && strncmp(storage[2].name, "cache", 5) == 0);
+        assert(storage[3].id == 1);
+        assert(storage[3].end == input + strlen(input));
+        assert(kv_parse_sections_find(&dir, "") == 0);
+        assert(kv_parse_sections_find(&dir, "cache") == 2);
+        assert(kv_parse_sections_find(&dir, "notheader") == -1);
+    }
+
+    // **Test 2: Lookup Scoped To Section**
+    {
+        char buffer[100] = {0};
+        assert(kv_parse_buffer_section_get(&dir, "", "host", buffer, sizeof(buffer)) == 6);
+        assert(strcmp(buffer, "global") == 0);
+        assert(kv_parse_buffer_section_get(&dir, "cache", "host", buffer, sizeof(buffer)) == 9);
+        assert(strcmp(buffer, "cachehost") == 0);
+        assert(kv_parse_buffer_section_get(&dir, "cache", "port", buffer, sizeof(buffer)) == 0);
+        assert(strcmp(buffer, "") == 0);
+        assert(kv_parse_buffer_section_get(&dir, "missing", "host", buffer, sizeof(buffer)) == 0);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(kv_parse_buffer_section_get(&dir, "db", "host", buffer, sizeof(buffer)) == 6);
+        assert(strcmp(buffer, "dbhost") == 0);
+#else
+        assert(kv_parse_buffer_section_get(&dir, "db", "host", buffer, sizeof(buffer)) == 6);
+        assert(strcmp(buffer, "second") == 0);
+#endif
+    }
+
+    // **Test 3: Repeated Section Searched In Order**
+    {
+        char buffer[100] = {0};
+        assert(kv_parse_buffer_section_get(&dir, "db", "user", buffer, sizeof(buffer)) == 5);
+        assert(strcmp(buffer, "admin") == 0);
+        assert(kv_parse_buffer_section_get(&dir, "db", "port", buffer, sizeof(buffer)) == 4);
+        assert(strcmp(buffer, "5432") == 0);
+    }
+
+    // **Test 4: Directory Capacity**
+    {
+        kv_parse_section small[2];
+        kv_parse_sections small_dir;
+        char buffer[100] = {0};
+        kv_parse_sections_init(&small_dir, small, 2);
+        assert(!kv_parse_buffer_sections(&small_dir, input));
+        assert(small_dir.count == 2);
+        assert(kv_parse_buffer_section_get(&small_dir, "db", "port", buffer, sizeof(buffer)) == 4);
+        assert(kv_parse_buffer_section_get(&small_dir, "cache", "host", buffer, sizeof(buffer)) == 0);
+    }
+
+    // **Test 5: Empty Buffer**
+    {
+        char buffer[100] = {0};
+        assert(kv_parse_buffer_sections(&dir, ""));
+        assert(dir.count == 1 && dir.names == 1);
+        assert(kv_parse_buffer_section_get(&dir, "", "key", buffer, sizeof(buffer)) == 0);
+    }
+
+    // **Test 6: Empty Section Name Is Not A Header In Any Engine**
+    {
+        char text[] = "a=1\n[]\nb=2\n[x]\nc=3\n";
+        char buffer[100] = {0};
+
+        // Section directory
+        assert(kv_parse_buffer_sections(&dir, text));
+        assert(dir.count == 2 && dir.names == 2);
+        assert(kv_parse_buffer_section_get(&dir, "", "b", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "2") == 0);
+        assert(kv_parse_buffer_section_get(&dir, "x", "c", buffer, sizeof(buffer)) == 1);
+
+        // check_section on the buffer and FILE engines
+        assert(kv_parse_buffer_check_section(kv_parse_buffer_next_line(text, 1), buffer, sizeof(buffer)) == 0);
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs("[]\n", temp);
+        rewind(temp);
+        assert(kv_parse_check_section(temp, buffer, sizeof(buffer)) == 0);
+        fclose(temp);
+
+        // Record iterator and index. Range i holds the records with section id i
+        static unsigned char index_storage[KV_PARSE_INDEX_BYTES(4)];
+        static const size_t section_ids[] = {0, 0, 1};
+        kv_parse_index index;
+        kv_parse_buffer_iter it;
+        kv_parse_record rec;
+        kv_parse_index_init(&index, index_storage, 4);
+        assert(kv_parse_buffer_index(&index, text));
+        assert(index.count == 3);
+        kv_parse_buffer_iter_init(&it, text);
+        for (size_t entry = 0; kv_parse_buffer_iter_next(&it, &rec); entry++)
+        {
+            assert(rec.section_id == section_ids[entry]);
+            assert(index.section_id[entry] == section_ids[entry]);
+            assert(rec.key >= storage[rec.section_id].start && rec.key < storage[rec.section_id].end);
+        }
+    }
+
+    // **Test 7: Many Names Are Interned Through The Hash Table**
+    {
+        const size_t names = UINT16_MAX + 2;
+        kv_parse_sections many;
+        kv_parse_section *sections = malloc((names + 1) * sizeof(kv_parse_section));
+        char *text = malloc(names * 12 + 1);
+        char *pos = text;
+        char name[16];
+        char buffer[100] = {0};
+        assert(sections != NULL && text != NULL);
+
+        /* Each name twice, so repeats must find the first occurrence */
+        for (size_t i = 0; i < 1000; i++)
+        {
+            pos += sprintf(pos, "[s%zu]\nk=%zu\n", i % 500, i);
+        }
+        *pos = '\0';
+        kv_parse_sections_init(&many, sections, 1001);
+        assert(kv_parse_buffer_sections(&many, text));
+        assert(many.count == 1001 && many.names == 501);
+        for (size_t i = 0; i < 1000; i++)
+        {
+            assert(sections[i + 1].id == 1 + i % 500);
+        }
+        assert(kv_parse_sections_find(&many, "s499") == 500);
+        assert(kv_parse_buffer_section_get(&many, "s7", "k", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "7") == 0);
+
+        /* Ids stop at UINT16_MAX */
+        pos = text;
+        for (size_t i = 0; i < names; i++)
+        {
+            pos += sprintf(pos, "[n%zu]\n", i);
+        }
+        *pos = '\0';
+        kv_parse_sections_init(&many, sections, names + 1);
+        assert(!kv_parse_buffer_sections(&many, text));
+        assert(many.names == (size_t)UINT16_MAX + 1);
+        assert(many.count == (size_t)UINT16_MAX + 1);
+        sprintf(name, "n%u", UINT16_MAX - 1);
+        assert(kv_parse_sections_find(&many, name) == UINT16_MAX);
+        free(sections);
+        free(text);
+    }
+
+    printf("kv_parse_buffer_section_get() passed successfully!\n");
+}
+
+/* Threads the parallel indexer is expected to use */
+#ifdef KV_PARSE_DISABLE_THREADS
+#define KV_PARSE_TEST_INDEX_THREADS(n) 1
+#else
+#define KV_PARSE_TEST_INDEX_THREADS(n) (n)
+#endif
+
+void run_kv_parse_buffer_index_parallel_tests()
+{
+    /* Large enough to be split across threads */
+    static char input[512 * 1024];
+    static unsigned char storage[KV_PARSE_INDEX_BYTES(32768)];
+    static unsigned char parallel_storage[KV_PARSE_INDEX_BYTES(32768)];
+    kv_parse_index index;
+    kv_parse_index parallel;
+
+    size_t len = 0;
+    for (int i = 0; len < sizeof(input) - 64; i++)
+    {
+        if (i % 1000 == 0)
+        {
+            len += sprintf(input + len, "[section%d]\r\n", i / 1000);
+        }
+        else if (i % 7 == 0)
+        {
+            /* Duplicate keys. First occurrence wins */
+            len += sprintf(input + len, "dup%d = %d\n", i % 50, i);
+        }
+        else
+        {
+            len += sprintf(input + len, "key%d=value%d\n", i, i);
+        }
+    }
+
+    // **Test 1: Same Index As Sequential Build**
+    {
+        kv_parse_index_init(&index, storage, 32768);
+        kv_parse_index_init(&parallel, parallel_storage, 32768);
+        assert(kv_parse_buffer_index(&index, input));
+        for (size_t threads = 0; threads <= 8; threads++)
+        {
+            assert(kv_parse_buffer_index_parallel(&parallel, input, threads));
+            /* One thread per 64 KiB at most */
+            assert(threads < 2 || parallel.threads == KV_PARSE_TEST_INDEX_THREADS(threads < len / (64 * 1024) ? threads : len / (64 * 1024)));
+            assert(parallel.count == index.count);
+            assert(memcmp(parallel.key_offset, index.key_offset, index.count * sizeof(size_t)) == 0);
+            assert(memcmp(parallel.value_offset, index.value_offset, index.count * sizeof(size_t)) == 0);
+            assert(memcmp(parallel.key_len, index.key_len, index.count * sizeof(uint32_t)) == 0);
+            assert(memcmp(parallel.value_len, index.value_len, index.count * sizeof(uint32_t)) == 0);
+            assert(memcmp(parallel.hash, index.hash, index.count * sizeof(uint32_t)) == 0);
+            assert(memcmp(parallel.section_id, index.section_id, index.count * sizeof(uint32_t)) == 0);
+
+            /* Every key finds its first occurrence in the concurrently filled table */
+            for (size_t entry = 0; entry < index.count; entry++)
+            {
+                char key[32] = {0};
+                memcpy(key, index.buffer + index.key_offset[entry], index.key_len[entry]);
+                assert(kv_parse_index_get_view(&parallel, key).ptr == kv_parse_index_get_view(&index, key).ptr);
+            }
+        }
+    }
+
+    // **Test 2: Lookups Match**
+    {
+        static const char *keys[] = {"key1", "dup7", "dup21", "key20001", "key29999", "section3", "missing"};
+        for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+        {
+            char expected[100] = {0};
+            char buffer[100] = {0};
+            size_t expected_count = kv_parse_index_get(&index, keys[i], expected, sizeof(expected));
+            assert(kv_parse_index_get(&parallel, keys[i], buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        char buffer[100] = {0};
+        assert(kv_parse_index_get(&parallel, "dup7", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "7") == 0);
+#endif
+    }
+
+    // **Test 3: Capacity Overflow Matches Sequential Build**
+    {
+        kv_parse_index_init(&index, storage, 1000);
+        kv_parse_index_init(&parallel, parallel_storage, 1000);
+        assert(!kv_parse_buffer_index(&index, input));
+        assert(!kv_parse_buffer_index_parallel(&parallel, input, 4));
+        assert(parallel.threads == KV_PARSE_TEST_INDEX_THREADS(4));
+        assert(parallel.count == index.count);
+        assert(memcmp(parallel.key_offset, index.key_offset, index.count * sizeof(size_t)) == 0);
+    }
+
+    // **Test 4: Small Input**
+    {
+        char small[] = "a=1\n[s]\nb=2\na=3\n";
+        char buffer[100] = {0};
+        kv_parse_index_init(&parallel, parallel_storage, 8);
+        assert(kv_parse_buffer_index_parallel(&parallel, small, 4));
+        assert(parallel.count == 3);
+        assert(parallel.section_id[1] == 1);
+        assert(kv_parse_index_get(&parallel, "a", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "1") == 0);
+    }
+
+    // **Test 5: Capacity Of Exactly The Entry Count Stays Parallel**
+    {
+        kv_parse_index_init(&index, storage, 32768);
+        assert(kv_parse_buffer_index(&index, input));
+        size_t count = index.count;
+
+        kv_parse_index_init(&parallel, parallel_storage, count);
+        assert(kv_parse_buffer_index_parallel(&parallel, input, 4));
+        assert(parallel.threads == KV_PARSE_TEST_INDEX_THREADS(4));
+        assert(parallel.count == count);
+        assert(memcmp(parallel.key_offset, index.key_offset, count * sizeof(size_t)) == 0);
+        assert(memcmp(parallel.section_id, index.section_id, count * sizeof(uint32_t)) == 0);
+    }
+
+    // **Test 6: Skewed Line Lengths Stay Parallel**
+    {
+        static char skewed[512 * 1024];
+        char value[200];
+        memset(value, 'v', sizeof(value) - 1);
+        value[sizeof(value) - 1] = '\0';
+
+        /* Long lines in the first half, short lines in the second, so entries are far from proportional to bytes */
+        size_t skewed_len = 0;
+        for (int i = 0; skewed_len < sizeof(skewed) / 2; i++)
+        {
+            skewed_len += (size_t)sprintf(skewed + skewed_len, "long%d=%s\n", i, value);
+        }
+        for (int i = 0; skewed_len < sizeof(skewed) - 64; i++)
+        {
+            skewed_len += (size_t)sprintf(skewed + skewed_len, "s%d=%d\n", i, i);
+        }
+
+        kv_parse_index_init(&index, storage, 32768);
+        assert(kv_parse_buffer_index(&index, skewed));
+        size_t count = index.count;
+
+        kv_parse_index_init(&parallel, parallel_storage, 2 * count < 32768 ? 2 * count : 32768);
+        assert(kv_parse_buffer_index_parallel(&parallel, skewed, 4));
+        assert(parallel.threads == KV_PARSE_TEST_INDEX_THREADS(4));
+        assert(parallel.count == count);
+        assert(memcmp(parallel.key_offset, index.key_offset, count * sizeof(size_t)) == 0);
+    }
+
+    printf("kv_parse_buffer_index_parallel() passed successfully!\n");
+}
+
+static const kv_key kv_parse_test_key = KV_PARSE_KEY("a_rather_long_key_name_for_hashing");
+
+void run_kv_parse_key_tests()
+{
+    // **Test 1: Compile Time Hash Matches Runtime Hash**
+    {
+        static const kv_key keys[] = {
+            KV_PARSE_KEY(""),
+            KV_PARSE_KEY("k"),
+            KV_PARSE_KEY("seven77"),
+            KV_PARSE_KEY("eight888"),
+            KV_PARSE_KEY("nine99999"),
+            KV_PARSE_KEY("sixteen_chars_16"),
+            KV_PARSE_KEY("seventeen_chars17"),
+            KV_PARSE_KEY("thirty_two_characters_long_key32"),
+            KV_PARSE_KEY("server.database.primary.connection.timeout"),
+        };
+        for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+        {
+            kv_key key = kv_parse_key(keys[i].str);
+            assert(key.len == keys[i].len);
+            assert(key.hash == keys[i].hash);
+        }
+        assert(kv_parse_test_key.len == 34);
+        assert(kv_parse_test_key.hash == kv_parse_key_hash("a_rather_long_key_name_for_hashing", 34));
+
+        /* Keys sharing a long prefix still differ in hash */
+        kv_key host = kv_parse_key("server.database.primary.host");
+        kv_key port = kv_parse_key("server.database.primary.port");
+        assert(host.hash != port.hash);
+    }
+
+    // **Test 1b: Keys Differing Only In The Middle Do Not Collide**
+    {
+        static uint32_t hashes[4000];
+        char key[64];
+
+        for (size_t i = 0; i < 4000; i++)
+        {
+            sprintf(key, "APP_CONFIG_SERVICE_%05zu_CONNECTION_TIMEOUT_MS", i);
+            hashes[i] = kv_parse_key_hash(key, strlen(key));
+        }
+
+        size_t collisions = 0;
+        for (size_t i = 0; i < 4000; i++)
+        {
+            for (size_t j = i + 1; j < 4000; j++)
+            {
+                collisions += hashes[i] == hashes[j];
+            }
+        }
+        assert(collisions == 0);
+
+        // Bytes past the compile time limit are hashed too
+        char long_a[100];
+        char long_b[100];
+        memset(long_a, 'x', sizeof(long_a));
+        memset(long_b, 'x', sizeof(long_b));
+        long_b[80] = 'y';
+        assert(kv_parse_key_hash(long_a, sizeof(long_a)) != kv_parse_key_hash(long_b, sizeof(long_b)));
+
+        static const kv_key longest = KV_PARSE_KEY("0123456789012345678901234567890123456789012345678901234567890123");
+        assert(longest.len == KV_PARSE_KEY_HASH_BYTES);
+        assert(longest.hash == kv_parse_key_hash(longest.str, longest.len));
+    }
+
+    // **Test 2: Buffer And Span Match Agree With Check Key**
+    {
+        static const char *lines[] = {
+            "key=value",
+            "  key  =  value  ",
+            "key:value",
+            "keyx=value",
+            "ke=value",
+            "key",
+            "",
+            "key value",
+            "a_rather_long_key_name_for_hashing = yes",
+            "a_rather_long_key_name_for_hashinG = no",
+            "a_rather_long_key_name_for_hash",
+            "a_rather_long_key_name_for_hashing",
+        };
+        static const char *keys[] = {"key", "ke", "", "a_rather_long_key_name_for_hashing", "a_rather_long"};
+        for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+        {
+            for (size_t j = 0; j < sizeof(keys) / sizeof(keys[0]); j++)
+            {
+                char line[64] = {0};
+                strcpy(line, lines[i]);
+                kv_key key = kv_parse_key(keys[j]);
+                char *expected = kv_parse_buffer_check_key(line, keys[j]);
+                assert(kv_parse_buffer_match_key(line, &key) == expected);
+                assert(kv_parse_span_match_key(line, line + strlen(line), &key) == kv_parse_span_check_key(line, line + strlen(line), keys[j]));
+            }
+        }
+    }
+
+    // **Test 3: Key Crossing A Page Boundary**
+    {
+        static char pages[3 * 4096];
+        char *page_end = (char *)(((uintptr_t)pages + 4096) & ~(uintptr_t)4095) + 4096;
+        for (size_t offset = 1; offset < 40; offset++)
+        {
+            char *line = page_end - offset;
+            strcpy(line, "a_rather_long_key_name_for_hashing=1");
+            assert(kv_parse_buffer_match_key(line, &kv_parse_test_key) == line + 35);
+            line[20] = 'X';
+            assert(kv_parse_buffer_match_key(line, &kv_parse_test_key) == NULL);
+            strcpy(line, "a_rather");
+            assert(kv_parse_buffer_match_key(line, &kv_parse_test_key) == NULL);
+        }
+    }
+
+    // **Test 4: FILE Match Agrees With Check Key**
+    {
+        static const char input[] = "other=1\n  a_rather_long_key_name_for_hashing : found\nkey=2\n";
+        FILE *file = tmpfile();
+        assert(file != NULL);
+        fputs(input, file);
+        static const kv_key key = KV_PARSE_KEY("key");
+        char buffer[100] = {0};
+
+        rewind(file);
+        assert(!kv_parse_match_key(file, &key));
+        assert(ftell(file) == 0);
+        assert(kv_parse_next_line(file, 1));
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(kv_parse_match_key(file, &kv_parse_test_key));
+        assert(kv_parse_get_value(file, buffer, sizeof(buffer)) == 5);
+        assert(strcmp(buffer, "found") == 0);
+#else
+        assert(!kv_parse_match_key(file, &kv_parse_test_key));
+#endif
+        fseek(file, (long)strlen(input) - 6, SEEK_SET);
+        assert(kv_parse_match_key(file, &key));
+        assert(kv_parse_get_value(file, buffer, sizeof(buffer)) == 1);
+        assert(!kv_parse_match_key(file, &key));
+        fclose(file);
+    }
+
+    // **Test 5: Index Lookup With Key Descriptor**
+    {
+        static unsigned char storage[KV_PARSE_INDEX_BYTES(8)];
+        static const kv_key key = KV_PARSE_KEY("key2");
+        static const kv_key missing = KV_PARSE_KEY("missing");
+        char input[] = "key1=one\nkey2=two\nkey2=dup\n";
+        char buffer[100] = {0};
+        kv_parse_index index;
+        kv_parse_index_init(&index, storage, 8);
+        kv_parse_buffer_index(&index, input);
+        assert(kv_parse_index_get_key(&index, &key, buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "two") == 0);
+        assert(kv_parse_index_get_key(&index, &missing, buffer, sizeof(buffer)) == 0);
+    }
+
+    printf("kv_parse_key() passed successfully!\n");
+}
+
+void run_kv_parse_class_tests()
+{
+    // **Test 1: Default Classes**
+    {
+        assert(KV_PARSE_IS(' ', KV_PARSE_CLASS_SPACE));
+        assert(KV_PARSE_IS('\t', KV_PARSE_CLASS_SPACE));
+        assert(KV_PARSE_IS('=', KV_PARSE_CLASS_DELIMITER));
+        assert(KV_PARSE_IS(':', KV_PARSE_CLASS_DELIMITER));
+        assert(KV_PARSE_IS('"', KV_PARSE_CLASS_QUOTE));
+        assert(KV_PARSE_IS('\'', KV_PARSE_CLASS_QUOTE));
+        assert(KV_PARSE_IS('\r', KV_PARSE_CLASS_EOL));
+        assert(KV_PARSE_IS('\n', KV_PARSE_CLASS_EOL | KV_PARSE_CLASS_LINE_FEED));
+        assert(KV_PARSE_IS('\0', KV_PARSE_CLASS_NUL));
+        assert(KV_PARSE_IS_CH(EOF, KV_PARSE_CLASS_EOF));
+        assert(!KV_PARSE_IS('\r', KV_PARSE_CLASS_LINE_FEED));
+        assert(!KV_PARSE_IS('~', KV_PARSE_CLASS_DELIMITER));
+        assert(!KV_PARSE_IS((char)0xFF, KV_PARSE_CLASS_SPACE | KV_PARSE_CLASS_DELIMITER | KV_PARSE_CLASS_QUOTE | KV_PARSE_CLASS_EOL | KV_PARSE_CLASS_NUL | KV_PARSE_CLASS_EOF));
+        assert(kv_parse_class_extra_delimiters == 0);
+    }
+
+    // **Test 2: Reserved Characters Are Rejected**
+    {
+        assert(!kv_parse_class_add_delimiter(' '));
+        assert(!kv_parse_class_add_delimiter('\t'));
+        assert(!kv_parse_class_add_delimiter('"'));
+        assert(!kv_parse_class_add_delimiter('\n'));
+        assert(!kv_parse_class_add_delimiter('\0'));
+        assert(!kv_parse_class_add_delimiter('['));
+        assert(kv_parse_class_add_delimiter('='));
+        assert(kv_parse_class_extra_delimiters == 0);
+    }
+
+    // **Test 3: Registered Delimiter Is Accepted By Every Parser**
+    {
+        assert(kv_parse_class_add_delimiter('~'));
+        assert(kv_parse_class_add_delimiter('~'));
+        assert(kv_parse_class_extra_delimiters == 1);
+
+        char input[] = "[net]\nhost~example\nport = 80\n";
+        char buffer[100] = {0};
+
+        /* Buffer */
+        char *line = kv_parse_buffer_next_line(input, 1);
+        assert(kv_parse_buffer_scan_delimiter(line) == line + 4);
+        assert(kv_parse_buffer_check_key(line, "host") != NULL);
+        assert(kv_parse_buffer(input, "host", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "example") == 0);
+
+        /* Span */
+        assert(kv_parse_span_check_key(line, line + 12, "host") == line + 5);
+        assert(kv_parse_span_get_value(line + 5, line + 12, buffer, sizeof(buffer)) == 7);
+
+        /* Iterator */
+        kv_parse_buffer_iter it;
+        kv_parse_record rec;
+        kv_parse_buffer_iter_init(&it, input);
+        assert(kv_parse_buffer_iter_next(&it, &rec));
+        assert(rec.key_len == 4 && strncmp(rec.key, "host", 4) == 0);
+        assert(rec.section_len == 3 && strncmp(rec.section, "net", 3) == 0);
+
+        /* Index */
+        static unsigned char storage[KV_PARSE_INDEX_BYTES(4)];
+        kv_parse_index index;
+        kv_parse_index_init(&index, storage, 4);
+        assert(kv_parse_buffer_index(&index, input));
+        assert(index.count == 2);
+        assert(kv_parse_index_get(&index, "host", buffer, sizeof(buffer)) == 7);
+
+        /* Stream */
+        char output[256] = {0};
+        assert(kv_parse_streamed(input, 5, output) == 0);
+        assert(strncmp(output, "net/host=example;", 17) == 0);
+
+        /* File */
+        FILE *file = tmpfile();
+        assert(file != NULL);
+        fputs(input, file);
+        rewind(file);
+        assert(kv_parse_next_line(file, 1));
+        assert(kv_parse_check_key(file, "host"));
+        assert(kv_parse_get_value(file, buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "example") == 0);
+        fclose(file);
+
+        kv_parse_class_reset();
+        assert(kv_parse_class_extra_delimiters == 0);
+        assert(kv_parse_buffer_check_key(line, "host") == NULL);
+    }
+
+    // **Test 4: Vector Delimiter Scan Sees Registered Delimiters Past The First Block**
+    {
+        assert(kv_parse_class_add_delimiter('~'));
+        assert(kv_parse_class_add_delimiter('|'));
+        assert(strcmp(kv_parse_class_delimiters, "=:\n~|") == 0);
+
+        /* Delimiter at every offset up to two AVX2 blocks, at every alignment */
+        static char input[160];
+        for (size_t at = 0; at < 70; at++)
+        {
+            for (size_t align = 0; align < 32; align += 7)
+            {
+                memset(input, 'k', sizeof(input));
+                input[align + at] = (at & 1) ? '|' : '~';
+                input[align + 100] = '\0';
+                assert(kv_parse_buffer_scan_delimiter(input + align) == input + align + at);
+            }
+        }
+
+        /* A default delimiter or line end still stops the scan first */
+        char mixed[] = "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa=b|c";
+        assert(kv_parse_buffer_scan_delimiter(mixed) == mixed + 41);
+
+        /* Registration stops once the scan set is full */
+        for (char ch = 'A'; kv_parse_class_extra_delimiters < KV_PARSE_CLASS_EXTRA_MAX; ch++)
+        {
+            assert(kv_parse_class_add_delimiter(ch));
+        }
+        assert(!kv_parse_class_add_delimiter('~' - 1));
+        assert(kv_parse_class_add_delimiter('~'));
+
+        kv_parse_class_reset();
+        assert(strcmp(kv_parse_class_delimiters, "=:\n") == 0);
+        assert(kv_parse_buffer_scan_delimiter(mixed) == mixed + 41);
+        assert(*kv_parse_buffer_scan_delimiter(mixed + 42) == '\0');
+    }
+
+    printf("kv_parse_class() passed successfully!\n");
+}
+
+void run_kv_parse_escape_tests()
+{
+    // **Test 1: Every Engine Decodes Escapes In Quoted Strings**
+    {
+        static const struct
+        {
+            const char *raw;
+            const char *decoded;
+            size_t len;
+        } cases[] = {
+            {"\"C:\\\\path\\\\\"", "C:\\path\\", 8},
+            {"\"say \\\"hi\\\"\" ignored", "say \"hi\"", 8},
+            {"'it\\'s'", "it's", 4},
+            {"\"a\\tb\\nc\\rd\"", "a\tb\nc\rd", 7},
+            {"\"\\x41\\x62c\\x7E\"", "Abc~", 4},
+            {"\"a\\0b\"", "a\0b", 3},
+            {"\"a\\qb\"", "a\\qb", 4},
+            {"\"\\x4Z\\x\"", "\\x4Z\\x", 6},
+            {"\"open\\\\", "open\\", 5},
+            {"pre \"\\\\\" post", "pre \\", 5},
+        };
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+        {
+            char line[64] = {0};
+            char buffer[64] = {0};
+            sprintf(line, "key=%s\nnext=1\n", cases[c].raw);
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+            const char *expected = cases[c].decoded;
+            size_t expected_len = cases[c].len;
+#else
+            const char *expected = cases[c].raw;
+            size_t expected_len = strlen(cases[c].raw);
+#endif
+
+            /* Buffer */
+            memset(buffer, 0x55, sizeof(buffer));
+            assert(kv_parse_buffer_get_value(line + 4, buffer, sizeof(buffer)) == expected_len);
+            assert(memcmp(buffer, expected, expected_len + 1) == 0);
+
+            /* Span */
+            memset(buffer, 0x55, sizeof(buffer));
+            assert(kv_parse_span_get_value(line + 4, line + strlen(line), buffer, sizeof(buffer)) == expected_len);
+            assert(memcmp(buffer, expected, expected_len + 1) == 0);
+
+            /* View */
+            memset(buffer, 0x55, sizeof(buffer));
+            kv_parse_view view = kv_parse_buffer_get_value_view(line + 4);
+            assert(kv_parse_view_unescape(view, buffer, sizeof(buffer)) == expected_len);
+            assert(memcmp(buffer, expected, expected_len + 1) == 0);
+
+            /* Index */
+            memset(buffer, 0x55, sizeof(buffer));
+            assert(kv_parse_indexed(line, "key", buffer, sizeof(buffer)) == expected_len);
+            assert(memcmp(buffer, expected, expected_len + 1) == 0);
+
+            /* File */
+            FILE *file = tmpfile();
+            assert(file != NULL);
+            fputs(line, file);
+            rewind(file);
+            memset(buffer, 0x55, sizeof(buffer));
+            assert(kv_parse_check_key(file, "key"));
+            assert(kv_parse_get_value(file, buffer, sizeof(buffer)) == expected_len);
+            assert(memcmp(buffer, expected, expected_len + 1) == 0);
+            fclose(file);
+
+            /* Stream, split at every byte */
+            char key[16];
+            char value[32];
+            kv_parse_stream stream;
+            kv_parse_stream_init(&stream, key, sizeof(key), value, sizeof(value), NULL, 0);
+            size_t pos = 0;
+            while (!stream.ready)
+            {
+                pos += kv_parse_stream_feed(&stream, line + pos, 1);
+            }
+            assert(stream.value_len == expected_len);
+            assert(memcmp(stream.value, expected, expected_len + 1) == 0);
+        }
+    }
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    // **Test 2: Escaped Value Too Large For Buffer**
+    {
+        char line[] = "key=\"C:\\\\path\\\\\"\n";
+        char buffer[16] = {0};
+        assert(kv_parse_buffer_get_value(line + 4, buffer, 9) == 8);
+        assert(kv_parse_buffer_get_value(line + 4, buffer, 8) == 0);
+        assert(kv_parse_span_get_value(line + 4, line + strlen(line), buffer, 8) == 0);
+        assert(kv_parse_view_unescape(kv_parse_buffer_get_value_view(line + 4), buffer, 8) == 0);
+        assert(buffer[0] == '\0');
+    }
+
+    // **Test 3: Long Quoted Value Copied In Runs**
+    {
+        static char line[8192];
+        static char expected[8192];
+        static char buffer[8192];
+        size_t len = 0;
+        char *out = line + sprintf(line, "pem=\"");
+        for (size_t row = 0; row < 64; row++)
+        {
+            for (size_t col = 0; col < 64; col++)
+            {
+                *out++ = expected[len++] = (char)('A' + (row + col) % 26);
+            }
+            out += sprintf(out, "\\n");
+            expected[len++] = '\n';
+        }
+        strcpy(out, "\"\r\nnext=1\n");
+        expected[len] = '\0';
+
+        assert(kv_parse_buffer_get_value(line + 4, buffer, sizeof(buffer)) == len);
+        assert(strcmp(buffer, expected) == 0);
+        assert(kv_parse_span_get_value(line + 4, line + strlen(line), buffer, sizeof(buffer)) == len);
+        assert(strcmp(buffer, expected) == 0);
+        kv_parse_view view = kv_parse_buffer_get_value_view(line + 4);
+        assert(view.flags == (KV_PARSE_VIEW_QUOTED | KV_PARSE_VIEW_ESCAPED));
+        assert(kv_parse_view_unescape(view, buffer, sizeof(buffer)) == len);
+        assert(strcmp(buffer, expected) == 0);
+    }
+#endif
+
+    printf("kv_parse_escape() passed successfully!\n");
+}
+
+void run_kv_parse_buffer_inplace_tests()
+{
+    // **Test 1: Records Match The Iterator**
+    {
+        static const char input[] = "top=1\r\n[net]\nhost = example.com \nnokey\n[ bad\nempty=\nquoted=\"a \\\"b\\\" c\\\\\" trailing\npath=\"C:\\\\dir\\\\\"\nmid=x \"y\\\\\" z\n[tls]\ncert='-----BEGIN-----\\nAAAA\\n-----END-----'\nlast:end";
+        char expected[sizeof(input)];
+        char buffer[sizeof(input)];
+        memcpy(expected, input, sizeof(input));
+        memcpy(buffer, input, sizeof(input));
+
+        kv_parse_buffer_iter reference;
+        kv_parse_buffer_iter it;
+        kv_parse_record rec;
+        kv_parse_buffer_iter_init(&reference, expected);
+        kv_parse_buffer_iter_init(&it, buffer);
+        char *key = NULL;
+        char *value = NULL;
+        size_t records = 0;
+        while ((key = kv_parse_buffer_inplace_next(&it, &value)) != NULL)
+        {
+            char expected_value[sizeof(input)];
+            assert(kv_parse_buffer_iter_next(&reference, &rec));
+            assert(strlen(key) == rec.key_len && strncmp(key, rec.key, rec.key_len) == 0);
+            assert(strlen(it.section) == rec.section_len && strncmp(it.section, rec.section, rec.section_len) == 0);
+            kv_parse_view_unescape(rec.value, expected_value, sizeof(expected_value));
+            assert(strcmp(value, expected_value) == 0);
+
+            /* Pointers point into the parsed buffer */
+            assert(key >= buffer && key < buffer + sizeof(buffer));
+            assert(value >= buffer && value < buffer + sizeof(buffer));
+            records++;
+        }
+        assert(!kv_parse_buffer_iter_next(&reference, &rec));
+        assert(records == 8);
+    }
+
+    // **Test 2: Pointers Stay Valid After Parsing**
+    {
+        char buffer[] = "[db]\nhost=localhost\nport = 5432\nname=\"app\\tdb\"\n";
+        char *keys[4];
+        char *values[4];
+        size_t count = 0;
+
+        kv_parse_buffer_iter it;
+        kv_parse_buffer_iter_init(&it, buffer);
+        assert(strcmp(it.section, "") == 0);
+        while ((keys[count] = kv_parse_buffer_inplace_next(&it, &values[count])) != NULL)
+        {
+            assert(strcmp(it.section, "db") == 0);
+            count++;
+        }
+        assert(count == 3);
+        assert(strcmp(keys[0], "host") == 0 && strcmp(values[0], "localhost") == 0);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(strcmp(keys[1], "port") == 0 && strcmp(values[1], "5432") == 0);
+#else
+        assert(strcmp(keys[1], "port ") == 0 && strcmp(values[1], " 5432") == 0);
+#endif
+        assert(strcmp(keys[2], "name") == 0);
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(strcmp(values[2], "app\tdb") == 0);
+#else
+        assert(strcmp(values[2], "\"app\\tdb\"") == 0);
+#endif
+        assert(kv_parse_buffer_inplace_next(&it, &values[0]) == NULL);
+    }
+
+    printf("kv_parse_buffer_inplace_next() passed successfully!\n");
+}
+
+void run_kv_parse_typed_tests()
+{
+    // **Test 1: Signed And Unsigned Integers**
+    {
+        int64_t i = 0;
+        uint64_t u = 0;
+        assert(kv_parse_buffer_get_i64("42\n", &i) == KV_PARSE_OK && i == 42);
+        assert(kv_parse_buffer_get_i64("-17", &i) == KV_PARSE_OK && i == -17);
+        assert(kv_parse_buffer_get_i64("+0\r\n", &i) == KV_PARSE_OK && i == 0);
+        assert(kv_parse_buffer_get_i64("9223372036854775807", &i) == KV_PARSE_OK && i == INT64_MAX);
+        assert(kv_parse_buffer_get_i64("-9223372036854775808", &i) == KV_PARSE_OK && i == INT64_MIN);
+        assert(kv_parse_buffer_get_i64("1234567890123456\nnext=1", &i) == KV_PARSE_OK && i == 1234567890123456);
+        assert(kv_parse_buffer_get_u64("18446744073709551615", &u) == KV_PARSE_OK && u == UINT64_MAX);
+        assert(kv_parse_buffer_get_u64("00000000000000000000000123", &u) == KV_PARSE_OK && u == 123);
+
+        /* Errors leave the output unchanged */
+        i = 7;
+        assert(kv_parse_buffer_get_i64("9223372036854775808", &i) == KV_PARSE_OVERFLOW);
+        assert(kv_parse_buffer_get_i64("-9223372036854775809", &i) == KV_PARSE_OVERFLOW);
+        assert(kv_parse_buffer_get_i64("123456789012345678901234567890", &i) == KV_PARSE_OVERFLOW);
+        assert(kv_parse_buffer_get_u64("18446744073709551616", &u) == KV_PARSE_OVERFLOW);
+        assert(kv_parse_buffer_get_i64("", &i) == KV_PARSE_EMPTY);
+        assert(kv_parse_buffer_get_i64("\nnext=1", &i) == KV_PARSE_EMPTY);
+        assert(kv_parse_buffer_get_i64("12a", &i) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_i64("12345678x", &i) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_i64("-", &i) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_i64("0x10", &i) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_u64("-1", &u) == KV_PARSE_INVALID);
+        assert(i == 7);
+
+        /* Every digit count, compared with strtoll */
+        for (size_t digits = 1; digits <= 18; digits++)
+        {
+            char line[32] = {0};
+            for (size_t d = 0; d < digits; d++)
+            {
+                line[d] = (char)('1' + (d * 7) % 9);
+            }
+            strcat(line, "\n");
+            assert(kv_parse_buffer_get_i64(line, &i) == KV_PARSE_OK && i == strtoll(line, NULL, 10));
+        }
+    }
+
+    // **Test 2: Whitespace And Quotes Around Numbers**
+    {
+        int64_t i = 0;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(kv_parse_buffer_get_i64("  42  \n", &i) == KV_PARSE_OK && i == 42);
+        assert(kv_parse_buffer_get_i64("   \n", &i) == KV_PARSE_EMPTY);
+#else
+        assert(kv_parse_buffer_get_i64("  42\n", &i) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_i64("42  \n", &i) == KV_PARSE_INVALID);
+#endif
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(kv_parse_buffer_get_i64("\"-5\" # comment\n", &i) == KV_PARSE_OK && i == -5);
+        assert(kv_parse_buffer_get_i64("'' \n", &i) == KV_PARSE_EMPTY);
+        assert(kv_parse_buffer_get_i64("\"5\n", &i) == KV_PARSE_INVALID);
+#else
+        assert(kv_parse_buffer_get_i64("\"-5\"\n", &i) == KV_PARSE_INVALID);
+#endif
+    }
+
+    // **Test 3: Floating Point**
+    {
+        static const char *values[] = {"0", "1.5", "-2.25", "3.14159", "1e10", "2.5E-3", "+.5", "7.", "123456789012345", "0.1", "1.7976931348623157e308", "4.9e-324", "0.30000000000000004", "1234567890123456789012345", "1e-30", "9007199254740993"};
+        for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); v++)
+        {
+            double d = 0;
+            assert(kv_parse_buffer_get_f64(values[v], &d) == KV_PARSE_OK);
+            assert(d == strtod(values[v], NULL));
+        }
+
+        double d = 1;
+        assert(kv_parse_buffer_get_f64("1e999", &d) == KV_PARSE_OVERFLOW);
+        assert(kv_parse_buffer_get_f64("-1e999", &d) == KV_PARSE_OVERFLOW);
+        assert(kv_parse_buffer_get_f64(".", &d) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_f64("1e", &d) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_f64("1.2.3", &d) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_f64("nan", &d) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_f64("0x1p3", &d) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_f64("", &d) == KV_PARSE_EMPTY);
+        assert(d == 1);
+    }
+
+    // **Test 4: Booleans**
+    {
+        bool b = false;
+        assert(kv_parse_buffer_get_bool("true\n", &b) == KV_PARSE_OK && b);
+        assert(kv_parse_buffer_get_bool("OFF", &b) == KV_PARSE_OK && !b);
+        assert(kv_parse_buffer_get_bool("Yes\r\n", &b) == KV_PARSE_OK && b);
+        assert(kv_parse_buffer_get_bool("0", &b) == KV_PARSE_OK && !b);
+        assert(kv_parse_buffer_get_bool("on", &b) == KV_PARSE_OK && b);
+        assert(kv_parse_buffer_get_bool("no", &b) == KV_PARSE_OK && !b);
+        assert(kv_parse_buffer_get_bool("truex", &b) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_bool("tru", &b) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_bool("2", &b) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_bool("", &b) == KV_PARSE_EMPTY);
+        assert(!b);
+    }
+
+    // **Test 5: Sizes And Durations**
+    {
+        size_t size = 0;
+        uint64_t ms = 0;
+        assert(kv_parse_buffer_get_size("512", &size) == KV_PARSE_OK && size == 512);
+        assert(kv_parse_buffer_get_size("64k", &size) == KV_PARSE_OK && size == 64 * 1024);
+        assert(kv_parse_buffer_get_size("64K\n", &size) == KV_PARSE_OK && size == 64 * 1024);
+        assert(kv_parse_buffer_get_size("16M", &size) == KV_PARSE_OK && size == 16 * 1024 * 1024);
+        assert(kv_parse_buffer_get_size("2G", &size) == KV_PARSE_OK && size == (size_t)2 << 30);
+        assert(kv_parse_buffer_get_size("2T", &size) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_size("-1k", &size) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_size("18446744073709551615k", &size) == KV_PARSE_OVERFLOW);
+
+        assert(kv_parse_buffer_get_duration("250", &ms) == KV_PARSE_OK && ms == 250);
+        assert(kv_parse_buffer_get_duration("250ms", &ms) == KV_PARSE_OK && ms == 250);
+        assert(kv_parse_buffer_get_duration("30s\n", &ms) == KV_PARSE_OK && ms == 30000);
+        assert(kv_parse_buffer_get_duration("5m", &ms) == KV_PARSE_OK && ms == 300000);
+        assert(kv_parse_buffer_get_duration("5h", &ms) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_duration("5mss", &ms) == KV_PARSE_INVALID);
+        assert(kv_parse_buffer_get_duration("18446744073709551615s", &ms) == KV_PARSE_OVERFLOW);
+    }
+
+    // **Test 6: Typed Value After Key Lookup**
+    {
+        char input[] = "name=server\nport=8080\ntimeout:30s\n";
+        int64_t port = 0;
+        uint64_t timeout = 0;
+        char *str = input;
+        for (size_t line = 0; (str = kv_parse_buffer_next_line(str, line)) != NULL; line++)
+        {
+            char *input_value = NULL;
+            if ((input_value = kv_parse_buffer_check_key(str, "port")) != NULL)
+            {
+                assert(kv_parse_buffer_get_i64(input_value, &port) == KV_PARSE_OK);
+            }
+            else if ((input_value = kv_parse_buffer_check_key(str, "timeout")) != NULL)
+            {
+                assert(kv_parse_buffer_get_duration(input_value, &timeout) == KV_PARSE_OK);
+            }
+            else if ((input_value = kv_parse_buffer_check_key(str, "name")) != NULL)
+            {
+                assert(kv_parse_buffer_get_i64(input_value, &port) == KV_PARSE_INVALID);
+            }
+        }
+        assert(port == 8080);
+        assert(timeout == 30000);
+    }
+
+    printf("kv_parse_typed() passed successfully!\n");
+}
+
+void run_kv_parse_kvc_tests()
+{
+    // **Test 1: Compiled Image Lookup**
+    {
+        char buffer[100] = {0};
+        unsigned char image[512];
+        kv_parse_kvc kvc;
+        const char *input = "a=one\r\nb=two\n# comment\nx=1\nx=2\n[s]\nc=\n";
+
+        size_t bound = kv_parse_kvc_compile(input, NULL, 0);
+        size_t size = kv_parse_kvc_compile(input, image, sizeof(image));
+        assert(size > KV_PARSE_KVC_HEADER_BYTES && size <= bound);
+        assert(kv_parse_kvc_bind(&kvc, image, size));
+        assert(kvc.count == 4);
+
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "one") == 0);
+        assert(kv_parse_kvc_get(&kvc, "b", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "two") == 0);
+        assert(kv_parse_kvc_get(&kvc, "x", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "1") == 0);
+        assert(kv_parse_kvc_get(&kvc, "c", buffer, sizeof(buffer)) == 0);
+        assert(kv_parse_kvc_get_view(&kvc, "c").ptr != NULL);
+        assert(kv_parse_kvc_get(&kvc, "z", buffer, sizeof(buffer)) == 0);
+        assert(kv_parse_kvc_get_view(&kvc, "z").ptr == NULL);
+        assert(kv_parse_kvc_get(&kvc, "# comment", buffer, sizeof(buffer)) == 0);
+
+        // Value too large for buffer
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, 3) == 0);
+        assert(buffer[0] == '\0');
+
+        // View is null terminated inside the image
+        kv_parse_view view = kv_parse_kvc_get_view(&kvc, "b");
+        assert(view.len == 3 && strcmp(view.ptr, "two") == 0);
+
+        // Key descriptor
+        static const kv_key key_x = KV_PARSE_KEY("x");
+        assert(kv_parse_kvc_get_key(&kvc, &key_x, buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "1") == 0);
+    }
+
+    // **Test 2: Image Does Not Fit**
+    {
+        unsigned char image[512];
+        const char *input = "key=value\nother=value\n";
+        size_t size = kv_parse_kvc_compile(input, image, sizeof(image));
+        assert(size > 0);
+        assert(kv_parse_kvc_compile(input, image, size - 1) == 0);
+        assert(kv_parse_kvc_compile(input, image, KV_PARSE_KVC_HEADER_BYTES) == 0);
+        assert(kv_parse_kvc_compile(input, image, size) == size);
+    }
+
+    // **Test 3: Empty Input**
+    {
+        char buffer[100] = {0};
+        unsigned char image[64];
+        kv_parse_kvc kvc;
+
+        size_t size = kv_parse_kvc_compile("# nothing\n\n", image, sizeof(image));
+        assert(size > 0);
+        assert(kv_parse_kvc_bind(&kvc, image, size));
+        assert(kvc.count == 0);
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 0);
+    }
+
+    // **Test 4: Malformed Images Are Rejected**
+    {
+        unsigned char image[512];
+        kv_parse_kvc kvc;
+
+        size_t size = kv_parse_kvc_compile("a=1\nb=2\n", image, sizeof(image));
+        assert(!kv_parse_kvc_bind(&kvc, image, size - 1));
+        assert(!kv_parse_kvc_bind(&kvc, image, KV_PARSE_KVC_HEADER_BYTES - 1));
+        image[0] = 'X';
+        assert(!kv_parse_kvc_bind(&kvc, image, size));
+        assert(!kv_parse_kvc_bind(&kvc, "a=1\nb=2\n plus some padding past the header", 40));
+    }
+
+    // **Test 5: Unaligned Image**
+    {
+        char buffer[100] = {0};
+        unsigned char image[512];
+        kv_parse_kvc kvc;
+
+        size_t size = kv_parse_kvc_compile("a=1\nb=2\n", image + 1, sizeof(image) - 1);
+        assert(kv_parse_kvc_bind(&kvc, image + 1, size));
+        assert(kv_parse_kvc_get(&kvc, "b", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "2") == 0);
+    }
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    // **Test 6: Values Are Stored Decoded**
+    {
+        char buffer[100] = {0};
+        unsigned char image[512];
+        kv_parse_kvc kvc;
+
+        size_t size = kv_parse_kvc_compile("a=\"x=1 # not a comment\"\nb=\"tab\\there\"\nc='q'\n", image, sizeof(image));
+        assert(kv_parse_kvc_bind(&kvc, image, size));
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 19);
+        assert(strcmp(buffer, "x=1 # not a comment") == 0);
+        assert(kv_parse_kvc_get(&kvc, "b", buffer, sizeof(buffer)) == 8);
+        assert(strcmp(buffer, "tab\there") == 0);
+        assert(kv_parse_kvc_get(&kvc, "c", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "q") == 0);
+    }
+#endif
+
+    // **Test 7: Image Matches The Buffer Parser On Many Keys**
+    {
+        enum
+        {
+            KEYS = 1000
+        };
+        char *input = malloc(KEYS * 32);
+        char key[32];
+        char expected[100];
+        char buffer[100];
+        kv_parse_kvc kvc;
+        assert(input != NULL);
+
+        char *ptr = input;
+        for (int i = 0; i < KEYS; i++)
+        {
+            ptr += sprintf(ptr, "key_%d=value_%d\n", i, i * 7);
+        }
+
+        size_t bound = kv_parse_kvc_compile(input, NULL, 0);
+        unsigned char *image = malloc(bound);
+        assert(image != NULL);
+        size_t size = kv_parse_kvc_compile(input, image, bound);
+        assert(kv_parse_kvc_bind(&kvc, image, size));
+        assert(kvc.count == KEYS);
+
+        for (int i = 0; i < KEYS + 10; i++)
+        {
+            sprintf(key, "key_%d", i);
+            expected[0] = '\0';
+            int expected_len = kv_parse_span_str(input, key, expected, sizeof(expected));
+            assert(kv_parse_kvc_get(&kvc, key, buffer, sizeof(buffer)) == (size_t)expected_len);
+            assert(strcmp(buffer, expected) == 0);
+        }
+
+        free(image);
+        free(input);
+    }
+
+    // **Test 8: Mapped Image File**
+    {
+        char buffer[100] = {0};
+        unsigned char image[512];
+        kv_parse_kvc kvc;
+
+        size_t size = kv_parse_kvc_compile("a=one\nb=two\n", image, sizeof(image));
+        FILE *temp = fopen("kv_parse_kvc_test.kvc", "wb");
+        assert(temp != NULL);
+        assert(fwrite(image, 1, size, temp) == size);
+        fclose(temp);
+
+        assert(kv_parse_kvc_open(&kvc, "kv_parse_kvc_test.kvc"));
+        assert(kvc.map != NULL);
+        assert(kv_parse_kvc_get(&kvc, "b", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "two") == 0);
+        kv_parse_kvc_close(&kvc);
+
+        // Text files are not images
+        temp = fopen("kv_parse_kvc_test.kvc", "wb");
+        assert(temp != NULL);
+        fputs("a=one\nb=two\nplus some padding past the header\n", temp);
+        fclose(temp);
+        assert(!kv_parse_kvc_open(&kvc, "kv_parse_kvc_test.kvc"));
+
+        remove("kv_parse_kvc_test.kvc");
+        assert(!kv_parse_kvc_open(&kvc, "kv_parse_kvc_test.missing"));
+    }
+
+    printf("kv_parse_kvc_get() passed successfully!\n");
+}
+
+void kv_parse_kvidx_write(const char *path, const char *content)
+{
+    FILE *temp = fopen(path, "w");
+    assert(temp != NULL);
+    fputs(content, temp);
+    fclose(temp);
+}
+
+void run_kv_parse_kvidx_tests()
+{
+    // **Test 1: Sidecar Is Built Once And Then Loaded**
+    {
+        char buffer[100] = {0};
+        kv_parse_kvc kvc;
+        struct stat st;
+
+        remove("kv_parse_kvidx_test.env.kvidx");
+        kv_parse_kvidx_write("kv_parse_kvidx_test.env", "a=one\nb=two\nb=three\n");
+
+        assert(!kv_parse_kvidx_load(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvidx_open(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kvc.map != NULL);
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "one") == 0);
+        assert(kv_parse_kvc_get(&kvc, "b", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "two") == 0);
+        kv_parse_kvc_close(&kvc);
+        assert(stat("kv_parse_kvidx_test.env.kvidx", &st) == 0);
+
+        assert(kv_parse_kvidx_load(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 3);
+        kv_parse_kvc_close(&kvc);
+    }
+
+    // **Test 2: Changed Source Makes The Sidecar Stale**
+    {
+        char buffer[100] = {0};
+        kv_parse_kvc kvc;
+
+        kv_parse_kvidx_write("kv_parse_kvidx_test.env", "a=changed\n");
+        assert(!kv_parse_kvidx_load(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvidx_open(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "changed") == 0);
+        assert(kv_parse_kvc_get(&kvc, "b", buffer, sizeof(buffer)) == 0);
+        kv_parse_kvc_close(&kvc);
+    }
+
+    // **Test 3: Same Size And Mtime But Different Content Is Caught By The Hash**
+    {
+        char buffer[100] = {0};
+        kv_parse_kvc kvc;
+
+        // Mtime ahead of the sidecar, as when the source is rewritten in the same second
+        struct timespec times[2] = {{0, UTIME_OMIT}, {4102444800, 0}};
+        kv_parse_kvidx_write("kv_parse_kvidx_test.env", "a=one\n");
+        assert(utimensat(AT_FDCWD, "kv_parse_kvidx_test.env", times, 0) == 0);
+        assert(kv_parse_kvidx_build("kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvidx_load(&kvc, "kv_parse_kvidx_test.env"));
+        kv_parse_kvc_close(&kvc);
+
+        kv_parse_kvidx_write("kv_parse_kvidx_test.env", "a=two\n");
+        assert(utimensat(AT_FDCWD, "kv_parse_kvidx_test.env", times, 0) == 0);
+        assert(!kv_parse_kvidx_load(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvidx_open(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "two") == 0);
+        kv_parse_kvc_close(&kvc);
+    }
+
+    // **Test 4: Replaced Source File Makes The Sidecar Stale**
+    {
+        kv_parse_kvc kvc;
+
+        // Same size, content and mtime under a new inode
+        struct timespec times[2] = {{0, UTIME_OMIT}, {1700000000, 0}};
+        kv_parse_kvidx_write("kv_parse_kvidx_test.env", "a=one\n");
+        kv_parse_kvidx_write("kv_parse_kvidx_test.env.new", "a=one\n");
+        assert(utimensat(AT_FDCWD, "kv_parse_kvidx_test.env", times, 0) == 0);
+        assert(utimensat(AT_FDCWD, "kv_parse_kvidx_test.env.new", times, 0) == 0);
+        assert(kv_parse_kvidx_build("kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvidx_load(&kvc, "kv_parse_kvidx_test.env"));
+        kv_parse_kvc_close(&kvc);
+
+        assert(rename("kv_parse_kvidx_test.env.new", "kv_parse_kvidx_test.env") == 0);
+        assert(!kv_parse_kvidx_load(&kvc, "kv_parse_kvidx_test.env"));
+    }
+
+    // **Test 5: Malformed Sidecar Is Rebuilt**
+    {
+        char buffer[100] = {0};
+        kv_parse_kvc kvc;
+
+        kv_parse_kvidx_write("kv_parse_kvidx_test.env.kvidx", "not a sidecar, just some text longer than both headers together..........");
+        assert(!kv_parse_kvidx_load(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvidx_open(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 3);
+        kv_parse_kvc_close(&kvc);
+    }
+
+    // **Test 6: Empty And Missing Sources**
+    {
+        char buffer[100] = {0};
+        kv_parse_kvc kvc;
+
+        kv_parse_kvidx_write("kv_parse_kvidx_test.env", "");
+        assert(kv_parse_kvidx_open(&kvc, "kv_parse_kvidx_test.env"));
+        assert(kv_parse_kvc_get(&kvc, "a", buffer, sizeof(buffer)) == 0);
+        kv_parse_kvc_close(&kvc);
+
+        remove("kv_parse_kvidx_test.env");
+        remove("kv_parse_kvidx_test.env.kvidx");
+        assert(!kv_parse_kvidx_open(&kvc, "kv_parse_kvidx_test.env"));
+        assert(!kv_parse_kvidx_build("kv_parse_kvidx_test.env"));
+        assert(!kv_parse_kvidx_open(&kvc, "/dev/null"));
+    }
+
+    printf("kv_parse_kvidx_open() passed successfully!\n");
+}
+
+#ifdef __linux__
+typedef struct kv_parse_live_test_reader
+{
+    kv_parse_live *live;
+    size_t reader;
+    bool *done;
+    size_t reads;
+    bool ordered;
+} kv_parse_live_test_reader;
+
+void *kv_parse_live_test_read(void *arg)
+{
+    kv_parse_live_test_reader *test = (kv_parse_live_test_reader *)arg;
+    char buffer[32];
+    long last = 0;
+
+    test->ordered = true;
+    while (!__atomic_load_n(test->done, __ATOMIC_ACQUIRE) || test->reads == 0)
+    {
+        // Published versions only move forward
+        assert(kv_parse_live_get(test->live, test->reader, "version", buffer, sizeof(buffer)) > 0);
+        long version = strtol(buffer, NULL, 10);
+        test->ordered = test->ordered && version >= last;
+        last = version;
+        test->reads++;
+    }
+    return NULL;
+}
+
+void run_kv_parse_live_tests()
+{
+    static kv_parse_live live;
+
+    // **Test 1: Load And Forced Reload**
+    {
+        char buffer[100] = {0};
+
+        kv_parse_kvidx_write("kv_parse_live_test.env", "a=one\nb=two\n");
+        assert(kv_parse_live_open(&live, "kv_parse_live_test.env"));
+        assert(kv_parse_live_get(&live, 0, "b", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "two") == 0);
+        assert(kv_parse_live_get(&live, 0, "c", buffer, sizeof(buffer)) == 0);
+
+        const kv_parse_live_snapshot *snapshot = kv_parse_live_enter(&live, 0);
+        assert(snapshot->generation == 0);
+        kv_parse_live_exit(&live, 0);
+
+        assert(kv_parse_live_reload(&live));
+        snapshot = kv_parse_live_enter(&live, 0);
+        assert(snapshot->generation == 1);
+        kv_parse_live_exit(&live, 0);
+    }
+
+    // **Test 2: File Rewritten In Place Is Reloaded**
+    {
+        char buffer[100] = {0};
+
+        kv_parse_kvidx_write("kv_parse_live_test.env", "a=changed\n");
+        assert(kv_parse_live_poll(&live, 1000));
+        assert(kv_parse_live_get(&live, 0, "a", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "changed") == 0);
+        assert(kv_parse_live_get(&live, 0, "b", buffer, sizeof(buffer)) == 0);
+    }
+
+    // **Test 3: File Replaced By Rename Is Reloaded**
+    {
+        char buffer[100] = {0};
+
+        kv_parse_kvidx_write("kv_parse_live_test.env.new", "a=renamed\n");
+        assert(rename("kv_parse_live_test.env.new", "kv_parse_live_test.env") == 0);
+        assert(kv_parse_live_poll(&live, 1000));
+        assert(kv_parse_live_get(&live, 0, "a", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "renamed") == 0);
+    }
+
+    // **Test 4: Other Files In The Directory Are Ignored**
+    {
+        kv_parse_kvidx_write("kv_parse_live_test.other", "a=other\n");
+        assert(!kv_parse_live_poll(&live, 1000));
+        assert(!kv_parse_live_poll(&live, 0));
+        remove("kv_parse_live_test.other");
+    }
+
+    // **Test 5: Snapshot Outlives The Swap Until The Reader Leaves**
+    {
+        char buffer[100] = {0};
+
+        const kv_parse_live_snapshot *snapshot = kv_parse_live_enter(&live, 1);
+        kv_parse_kvidx_write("kv_parse_live_test.env", "a=newer\n");
+        assert(kv_parse_live_reload(&live));
+        assert(live.retired != NULL);
+
+        // Old snapshot is unchanged and still readable
+        assert(kv_parse_index_get(&snapshot->index, "a", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "renamed") == 0);
+        assert(kv_parse_live_get(&live, 0, "a", buffer, sizeof(buffer)) == 5);
+        assert(strcmp(buffer, "newer") == 0);
+
+        kv_parse_live_exit(&live, 1);
+        kv_parse_live_poll(&live, 0);
+        assert(live.retired == NULL);
+    }
+
+    // **Test 6: Concurrent Readers During Reloads**
+    {
+        char content[64];
+        bool done = false;
+        pthread_t thread[2];
+        kv_parse_live_test_reader reader[2];
+
+        kv_parse_kvidx_write("kv_parse_live_test.env", "name=test\nversion=0\n");
+        assert(kv_parse_live_reload(&live));
+        for (size_t i = 0; i < 2; i++)
+        {
+            reader[i].live = &live;
+            reader[i].reader = i + 1;
+            reader[i].done = &done;
+            reader[i].reads = 0;
+            assert(pthread_create(&thread[i], NULL, kv_parse_live_test_read, &reader[i]) == 0);
+        }
+
+        for (int version = 1; version <= 200; version++)
+        {
+            sprintf(content, "name=test\nversion=%d\n", version);
+            kv_parse_kvidx_write("kv_parse_live_test.env", content);
+            assert(kv_parse_live_reload(&live));
+        }
+
+        __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+        for (size_t i = 0; i < 2; i++)
+        {
+            pthread_join(thread[i], NULL);
+            assert(reader[i].reads > 0 && reader[i].ordered);
+        }
+
+        kv_parse_live_poll(&live, 0);
+        assert(live.retired == NULL);
+        kv_parse_live_close(&live);
+    }
+
+    // **Test 7: Missing File**
+    {
+        remove("kv_parse_live_test.env");
+        assert(!kv_parse_live_open(&live, "kv_parse_live_test.env"));
+    }
+
+    printf("kv_parse_live_get() passed successfully!\n");
+}
+#endif
+
+typedef struct kv_parse_pread_test_reader
+{
+    int fd;
+    size_t first;
+    bool matched;
+} kv_parse_pread_test_reader;
+
+void *kv_parse_pread_test_read(void *arg)
+{
+    kv_parse_pread_test_reader *test = (kv_parse_pread_test_reader *)arg;
+    char key[32];
+    char expected[32];
+    char buffer[32];
+
+    test->matched = true;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        // Every thread walks its own keys through the one descriptor
+        size_t n = (test->first + i * 7) % 1000;
+        sprintf(key, "key%zu", n);
+        sprintf(expected, "value%zu", n);
+        test->matched = test->matched && kv_parse_pread_get(test->fd, key, buffer, sizeof(buffer)) == strlen(expected) && strcmp(buffer, expected) == 0;
+    }
+    return NULL;
+}
+
+size_t kv_pread_parse(int fd, const char *key, char *value, size_t value_max)
+{
+    kv_parse_cursor cursor;
+    kv_parse_pread_init(&cursor, fd);
+    for (size_t line = 0; kv_parse_pread_next_line(&cursor, line); line++)
+    {
+        if (kv_parse_pread_check_key(&cursor, key))
+        {
+            return kv_parse_pread_get_value(&cursor, value, value_max);
+        }
+    }
+    return 0;
+}
+
+void run_kv_parse_pread_tests()
+{
+    // **Test 1: Cursor Lookups**
+    {
+        char buffer[100] = {0};
+
+        kv_parse_kvidx_write("kv_parse_pread_test.env", "# comment\nname=test\nport=8080\nname=second\nlast=end");
+        int fd = open("kv_parse_pread_test.env", O_RDONLY);
+        assert(fd >= 0);
+
+        assert(kv_pread_parse(fd, "name", buffer, sizeof(buffer)) == 4);
+        assert(strcmp(buffer, "test") == 0);
+        assert(kv_pread_parse(fd, "port", buffer, sizeof(buffer)) == 4);
+        assert(strcmp(buffer, "8080") == 0);
+        assert(kv_pread_parse(fd, "last", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "end") == 0);
+        assert(kv_pread_parse(fd, "missing", buffer, sizeof(buffer)) == 0);
+
+        // Descriptor position is never moved
+        assert(lseek(fd, 0, SEEK_CUR) == 0);
+        close(fd);
+    }
+
+    // **Test 2: Direct Lookups Match The Cursor**
+    {
+        char buffer[100] = {0};
+
+        int fd = open("kv_parse_pread_test.env", O_RDONLY);
+        assert(fd >= 0);
+        assert(kv_parse_pread_get(fd, "name", buffer, sizeof(buffer)) == 4);
+        assert(strcmp(buffer, "test") == 0);
+        assert(kv_parse_pread_get(fd, "last", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "end") == 0);
+        assert(kv_parse_pread_get(fd, "missing", buffer, sizeof(buffer)) == 0);
+        assert(buffer[0] == '\0');
+        assert(kv_parse_pread_get(fd, "port", buffer, 3) == 0);
+        close(fd);
+    }
+
+    // **Test 3: Lines Across And Longer Than The Block**
+    {
+        static char content[3 * KV_PARSE_PREAD_BLOCK];
+        char buffer[100] = {0};
+
+        // Padding lines put `split` across the first block boundary, then a line longer than a block
+        size_t len = 0;
+        while (len < KV_PARSE_PREAD_BLOCK - 20)
+        {
+            len += (size_t)sprintf(content + len, "pad%zu=x\n", len);
+        }
+        len += (size_t)sprintf(content + len, "split=across the boundary\nlong=");
+        memset(content + len, 'y', KV_PARSE_PREAD_BLOCK + 100);
+        len += KV_PARSE_PREAD_BLOCK + 100;
+        sprintf(content + len, "\nafter=ok\n");
+        kv_parse_kvidx_write("kv_parse_pread_test.env", content);
+
+        int fd = open("kv_parse_pread_test.env", O_RDONLY);
+        assert(fd >= 0);
+        assert(kv_parse_pread_get(fd, "split", buffer, sizeof(buffer)) == 19);
+        assert(strcmp(buffer, "across the boundary") == 0);
+        assert(kv_pread_parse(fd, "split", buffer, sizeof(buffer)) == 19);
+        assert(kv_parse_pread_get(fd, "long", buffer, sizeof(buffer)) == 0);
+        assert(kv_pread_parse(fd, "long", buffer, sizeof(buffer)) == 0);
+        assert(kv_parse_pread_get(fd, "after", buffer, sizeof(buffer)) == 2);
+        assert(strcmp(buffer, "ok") == 0);
+        assert(kv_pread_parse(fd, "after", buffer, sizeof(buffer)) == 2);
+        assert(strcmp(buffer, "ok") == 0);
+        close(fd);
+    }
+
+    // **Test 4: Sections**
+    {
+        char section[32] = {0};
+        kv_parse_cursor cursor;
+
+        kv_parse_kvidx_write("kv_parse_pread_test.env", "a=1\n[server]\nport=80\n");
+        int fd = open("kv_parse_pread_test.env", O_RDONLY);
+        assert(fd >= 0);
+
+        kv_parse_pread_init(&cursor, fd);
+        assert(kv_parse_pread_next_line(&cursor, 0));
+        assert(kv_parse_pread_check_section(&cursor, section, sizeof(section)) == 0);
+        assert(kv_parse_pread_next_line(&cursor, 1));
+        assert(kv_parse_pread_check_section(&cursor, section, sizeof(section)) == 6);
+        assert(strcmp(section, "server") == 0);
+        assert(kv_parse_pread_next_line(&cursor, 2));
+        assert(!kv_parse_pread_next_line(&cursor, 3));
+        close(fd);
+    }
+
+    // **Test 5: Concurrent Lookups On One Descriptor**
+    {
+        static char content[1000 * 24];
+        pthread_t thread[4];
+        kv_parse_pread_test_reader reader[4];
+
+        size_t len = 0;
+        for (size_t i = 0; i < 1000; i++)
+        {
+            len += (size_t)sprintf(content + len, "key%zu=value%zu\n", i, i);
+        }
+        kv_parse_kvidx_write("kv_parse_pread_test.env", content);
+
+        int fd = open("kv_parse_pread_test.env", O_RDONLY);
+        assert(fd >= 0);
+        for (size_t i = 0; i < 4; i++)
+        {
+            reader[i].fd = fd;
+            reader[i].first = i * 250;
+            assert(pthread_create(&thread[i], NULL, kv_parse_pread_test_read, &reader[i]) == 0);
+        }
+        for (size_t i = 0; i < 4; i++)
+        {
+            pthread_join(thread[i], NULL);
+            assert(reader[i].matched);
+        }
+        close(fd);
+    }
+
+    // **Test 6: Short Lines Are Parsed From The Block Already Read**
+    {
+        char buffer[100] = {0};
+        char section[32] = {0};
+        kv_parse_cursor cursor;
+
+        kv_parse_kvidx_write("kv_parse_pread_test.env", "a=1\n[s]\nb=2\nc=3\n");
+        int fd = open("kv_parse_pread_test.env", O_RDONLY);
+        assert(fd >= 0);
+
+        kv_parse_pread_init(&cursor, fd);
+        assert(kv_parse_pread_next_line(&cursor, 0));
+        assert(cursor.block_offset == 0 && cursor.block_len == 16);
+        for (size_t line = 1; line < 4; line++)
+        {
+            assert(kv_parse_pread_next_line(&cursor, line));
+            assert(cursor.block_offset == 0);
+            if (line == 1)
+            {
+                assert(kv_parse_pread_check_section(&cursor, section, sizeof(section)) == 1);
+                assert(strcmp(section, "s") == 0);
+            }
+        }
+        assert(kv_parse_pread_check_key(&cursor, "c"));
+        assert(kv_parse_pread_get_value(&cursor, buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "3") == 0);
+        assert(!kv_parse_pread_next_line(&cursor, 4));
+        close(fd);
+    }
+
+    // **Test 7: Value Past The Block Of A Long Line**
+    {
+        static char content[2 * KV_PARSE_PREAD_BLOCK];
+        static char key[KV_PARSE_PREAD_BLOCK];
+        static char buffer[KV_PARSE_PREAD_BLOCK];
+
+        memset(key, 'k', KV_PARSE_PREAD_BLOCK / 2);
+        key[KV_PARSE_PREAD_BLOCK / 2] = '\0';
+        size_t len = (size_t)sprintf(content, "first=1\n%s=", key);
+        memset(content + len, 'v', KV_PARSE_PREAD_BLOCK / 2 + 100);
+        len += KV_PARSE_PREAD_BLOCK / 2 + 100;
+        sprintf(content + len, "\nlast=end");
+        kv_parse_kvidx_write("kv_parse_pread_test.env", content);
+
+        int fd = open("kv_parse_pread_test.env", O_RDONLY);
+        assert(fd >= 0);
+        assert(kv_pread_parse(fd, key, buffer, sizeof(buffer)) == KV_PARSE_PREAD_BLOCK / 2 + 100);
+        assert(buffer[0] == 'v' && buffer[KV_PARSE_PREAD_BLOCK / 2 + 99] == 'v');
+        assert(kv_pread_parse(fd, "last", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "end") == 0);
+
+        // Direct lookups cannot tell a long line from a missing key
+        assert(kv_parse_pread_get(fd, key, buffer, sizeof(buffer)) == 0);
+        assert(buffer[0] == '\0');
+        close(fd);
+    }
+
+    remove("kv_parse_pread_test.env");
+    printf("kv_parse_pread_get() passed successfully!\n");
+}
+
+int kv_lines_parse(kv_parse_lines *lines, FILE *file, const char *key, char *value, unsigned int value_max)
+{
+    rewind(file);
+    for (size_t line = 0; kv_parse_lines_next_line(lines, file, line); line++)
+    {
+        if (kv_parse_check_key(file, key))
+        {
+            return kv_parse_get_value(file, value, value_max);
+        }
+    }
+    return 0;
+}
+
+void run_kv_parse_lines_tests()
+{
+    // **Test 1: Lookups Record And Reuse Line Offsets**
+    {
+        static unsigned char storage[64];
+        char buffer[100] = {0};
+        kv_parse_lines lines;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs("a=1\n# comment\nb=two\n\nc=three", temp);
+
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 1);
+        assert(kv_lines_parse(&lines, temp, "c", buffer, sizeof(buffer)) == 5);
+        assert(strcmp(buffer, "three") == 0);
+        assert(lines.count == 5);
+        assert(!lines.complete);
+
+        // Second pass jumps between known lines
+        assert(kv_lines_parse(&lines, temp, "b", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "two") == 0);
+        assert(kv_lines_parse(&lines, temp, "missing", buffer, sizeof(buffer)) == 0);
+        assert(lines.complete && lines.total == 5);
+        assert(kv_lines_parse(&lines, temp, "a", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "1") == 0);
+        fclose(temp);
+    }
+
+    // **Test 2: Seek To Line**
+    {
+        static unsigned char storage[64];
+        char buffer[100] = {0};
+        kv_parse_lines lines;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs("k0=v0\nk1=v1\nk2=v2\nk3=v3\nk4=v4\n", temp);
+
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 1);
+        assert(kv_parse_seek_line(&lines, temp, 3));
+        assert(kv_parse_check_key(temp, "k3"));
+        assert(kv_parse_get_value(temp, buffer, sizeof(buffer)) == 2);
+        assert(strcmp(buffer, "v3") == 0);
+
+        // Backwards to a recorded line, then forwards past the recorded lines
+        assert(kv_parse_seek_line(&lines, temp, 1));
+        assert(kv_parse_check_key(temp, "k1"));
+        assert(kv_parse_seek_line(&lines, temp, 4));
+        assert(kv_parse_check_key(temp, "k4"));
+        assert(kv_parse_seek_line(&lines, temp, 0));
+        assert(kv_parse_check_key(temp, "k0"));
+
+        assert(!kv_parse_seek_line(&lines, temp, 5));
+        assert(lines.complete && lines.total == 5);
+        assert(!kv_parse_seek_line(&lines, temp, 100));
+        fclose(temp);
+    }
+
+    // **Test 3: Sparse Checkpoints**
+    {
+        static unsigned char storage[64];
+        char buffer[100] = {0};
+        char key[16];
+        kv_parse_lines lines;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        for (int i = 0; i < 100; i++)
+        {
+            fprintf(temp, "key%d=value%d\n", i, i);
+        }
+
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 16);
+        assert(kv_lines_parse(&lines, temp, "missing", buffer, sizeof(buffer)) == 0);
+        assert(lines.count == 7);
+        for (int i = 99; i >= 0; i -= 7)
+        {
+            sprintf(key, "key%d", i);
+            assert(kv_parse_seek_line(&lines, temp, (size_t)i));
+            assert(kv_parse_check_key(temp, key));
+        }
+        fclose(temp);
+    }
+
+    // **Test 4: Full Storage Falls Back To Walking**
+    {
+        static unsigned char storage[4];
+        char buffer[100] = {0};
+        kv_parse_lines lines;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        for (int i = 0; i < 20; i++)
+        {
+            fprintf(temp, "key%d=value%d\n", i, i);
+        }
+
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 1);
+        assert(kv_lines_parse(&lines, temp, "key19", buffer, sizeof(buffer)) == 7);
+        assert(lines.count == 5 && lines.used == 4);
+        assert(kv_lines_parse(&lines, temp, "key18", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "value18") == 0);
+        assert(kv_parse_seek_line(&lines, temp, 12));
+        assert(kv_parse_check_key(temp, "key12"));
+        fclose(temp);
+    }
+
+    // **Test 5: Distances Over One Varint Byte**
+    {
+        static unsigned char storage[64];
+        char buffer[100] = {0};
+        char value[400];
+        kv_parse_lines lines;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        memset(value, 'x', sizeof(value) - 1);
+        value[sizeof(value) - 1] = '\0';
+        fprintf(temp, "long=%s\nafter=ok\n", value);
+
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 1);
+        assert(kv_lines_parse(&lines, temp, "missing", buffer, sizeof(buffer)) == 0);
+        assert(lines.used == 2);
+        assert(kv_parse_seek_line(&lines, temp, 1));
+        assert(ftell(temp) == 405);
+        assert(kv_parse_check_key(temp, "after"));
+        fclose(temp);
+    }
+
+    // **Test 6: First Line Is Left In Place Like kv_parse_next_line()**
+    {
+        static unsigned char storage[64];
+        kv_parse_lines lines;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs("a=1\nb=2\n", temp);
+
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 1);
+        fseek(temp, 4, SEEK_SET);
+        assert(kv_parse_lines_next_line(&lines, temp, 0));
+        assert(ftell(temp) == 4);
+        assert(kv_parse_check_key(temp, "b"));
+        fclose(temp);
+    }
+
+    // **Test 7: Lookups Seek To Tagged Candidate Lines Only**
+    {
+        static unsigned char storage[64];
+        char buffer[100] = {0};
+        kv_parse_lines lines;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs("[net]\nhost=example\n# comment\nport:80\na b=spaced\n\nlast=end", temp);
+
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 1);
+        assert(kv_parse_lines_get(&lines, temp, "missing", buffer, sizeof(buffer)) == 0);
+        assert(lines.complete && lines.total == 7);
+        assert(lines.tagged == 7);
+
+        // Every key is still found through its tag
+        assert(kv_parse_lines_get(&lines, temp, "host", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "example") == 0);
+        assert(kv_parse_lines_get(&lines, temp, "port", buffer, sizeof(buffer)) == 2);
+        assert(strcmp(buffer, "80") == 0);
+        assert(kv_parse_lines_get(&lines, temp, "a b", buffer, sizeof(buffer)) == 6);
+        assert(strcmp(buffer, "spaced") == 0);
+        assert(kv_parse_lines_get(&lines, temp, "last", buffer, sizeof(buffer)) == 3);
+        assert(strcmp(buffer, "end") == 0);
+
+        // A key whose tag matches no line is rejected without reading the file
+        fseek(temp, 3, SEEK_SET);
+        assert(kv_parse_lines_get(&lines, temp, "missing", buffer, sizeof(buffer)) == 0);
+        assert(ftell(temp) == 3);
+        fclose(temp);
+    }
+
+    // **Test 8: Tags Share The Storage With Offsets**
+    {
+        static unsigned char storage[16];
+        char buffer[100] = {0};
+        char key[16];
+        kv_parse_lines lines;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        for (int i = 0; i < 20; i++)
+        {
+            fprintf(temp, "key%d=value%d\n", i, i);
+        }
+
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 1);
+        assert(kv_parse_lines_get(&lines, temp, "missing", buffer, sizeof(buffer)) == 0);
+        assert(lines.used + lines.tagged <= sizeof(storage));
+        assert(lines.tagged == 8 && lines.count == 9);
+        for (int i = 19; i >= 0; i--)
+        {
+            sprintf(key, "key%d", i);
+            assert(kv_parse_lines_get(&lines, temp, key, buffer, sizeof(buffer)) == strlen(key) + 2);
+        }
+
+        // No tags with sparse checkpoints, lookups still walk every line
+        kv_parse_lines_init(&lines, storage, sizeof(storage), 4);
+        assert(kv_parse_lines_get(&lines, temp, "key17", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "value17") == 0);
+        assert(lines.tagged == 0);
+        fclose(temp);
+    }
+
+    printf("kv_parse_lines_next_line() passed successfully!\n");
+}
+
+void run_kv_parse_bloom_tests()
+{
+    // **Test 1: Buffer Keys Are Never Rejected**
+    {
+        static unsigned char storage[KV_PARSE_BLOOM_BYTES(16)];
+        kv_parse_bloom bloom;
+        static const kv_key port = KV_PARSE_KEY("port");
+
+        kv_parse_bloom_init(&bloom, storage, sizeof(storage));
+        assert(!kv_parse_bloom_check(&bloom, "name"));
+
+        kv_parse_buffer_bloom(&bloom, "# comment\nname=test\n[server]\nport: 80\nnot a record\n");
+        assert(bloom.count == 2);
+        assert(kv_parse_bloom_check(&bloom, "name"));
+        assert(kv_parse_bloom_check(&bloom, "port"));
+        assert(kv_parse_bloom_check_key(&bloom, &port));
+        assert(!kv_parse_bloom_check(&bloom, "missing"));
+    }
+
+    // **Test 2: Keys Holding Delimiters Or Whitespace Are Never Rejected**
+    {
+        static unsigned char storage[KV_PARSE_BLOOM_BYTES(16)];
+        char input[] = "db:host=localhost\nname = x\n";
+        char buffer[100] = {0};
+        kv_parse_bloom bloom;
+
+        kv_parse_bloom_init(&bloom, storage, sizeof(storage));
+        kv_parse_buffer_bloom(&bloom, input);
+
+        // Every key the engines find is kept
+        assert(kv_parse_buffer_check_key(input, "db:host") != NULL);
+        assert(kv_parse_bloom_check(&bloom, "db:host"));
+        assert(kv_parse_bloom_check(&bloom, "db"));
+        assert(kv_parse_buffer_check_key(kv_parse_buffer_next_line(input, 1), "name ") != NULL);
+        assert(kv_parse_bloom_check(&bloom, "name "));
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs(input, temp);
+        char block[64];
+        kv_parse_bloom_init(&bloom, storage, sizeof(storage));
+        assert(kv_parse_file_bloom(&bloom, temp, block, sizeof(block)));
+        assert(kv_parse(temp, "db:host", buffer, sizeof(buffer)) == 9);
+        assert(kv_parse_bloom_check(&bloom, "db:host"));
+        assert(kv_parse_bloom_check(&bloom, "name "));
+        fclose(temp);
+    }
+
+    // **Test 3: Index Keys And False Positive Rate**
+    {
+        static char input[1000 * 24];
+        static unsigned char index_storage[KV_PARSE_INDEX_BYTES(1000)];
+        static unsigned char storage[KV_PARSE_BLOOM_BYTES(1000)];
+        char key[32];
+        kv_parse_index index;
+        kv_parse_bloom bloom;
+
+        size_t len = 0;
+        for (int i = 0; i < 1000; i++)
+        {
+            len += (size_t)sprintf(input + len, "key%d=value%d\n", i, i);
+        }
+
+        kv_parse_index_init(&index, index_storage, 1000);
+        assert(kv_parse_buffer_index(&index, input));
+        kv_parse_bloom_init(&bloom, storage, sizeof(storage));
+        kv_parse_index_bloom(&bloom, &index);
+        assert(bloom.count == 1000);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            sprintf(key, "key%d", i);
+            assert(kv_parse_bloom_check(&bloom, key));
+        }
+
+        // About 1% at 10 bits per key
+        size_t false_positives = 0;
+        for (int i = 0; i < 10000; i++)
+        {
+            sprintf(key, "absent%d", i);
+            false_positives += kv_parse_bloom_check(&bloom, key);
+        }
+        assert(false_positives < 300);
+    }
+
+    // **Test 4: File Keys Across Blocks**
+    {
+        static unsigned char storage[KV_PARSE_BLOOM_BYTES(200)];
+        char block[64];
+        char buffer[100] = {0};
+        char key[32];
+        kv_parse_bloom bloom;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        for (int i = 0; i < 200; i++)
+        {
+            fprintf(temp, "key%d=value%d\n", i, i);
+        }
+        fputs("last=end", temp);
+
+        kv_parse_bloom_init(&bloom, storage, sizeof(storage));
+        assert(kv_parse_file_bloom(&bloom, temp, block, sizeof(block)));
+        assert(bloom.count == 201);
+        for (int i = 0; i < 200; i++)
+        {
+            sprintf(key, "key%d", i);
+            assert(kv_parse_bloom_check(&bloom, key));
+        }
+        assert(kv_parse_bloom_check(&bloom, "last"));
+
+        // File is rewound for lookups
+        assert(kv_parse(temp, "last", buffer, sizeof(buffer)) == 3);
+        fclose(temp);
+    }
+
+    // **Test 5: Line Longer Than The Block Disables Rejection**
+    {
+        static unsigned char storage[KV_PARSE_BLOOM_BYTES(4)];
+        char block[16];
+        kv_parse_bloom bloom;
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs("a=1\nlong=0123456789abcdef\nb=2\n", temp);
+
+        kv_parse_bloom_init(&bloom, storage, sizeof(storage));
+        assert(!kv_parse_file_bloom(&bloom, temp, block, sizeof(block)));
+        assert(kv_parse_bloom_check(&bloom, "long"));
+        assert(kv_parse_bloom_check(&bloom, "missing"));
+        fclose(temp);
+    }
+
+    // **Test 6: Empty Storage Rejects Nothing**
+    {
+        kv_parse_bloom bloom;
+        kv_parse_bloom_init(&bloom, NULL, 0);
+        kv_parse_bloom_add(&bloom, "a", 1);
+        assert(kv_parse_bloom_check(&bloom, "missing"));
+    }
+
+    printf("kv_parse_bloom_check() passed successfully!\n");
+}
+
+void run_kv_parse_buffer_check_section()
+{
+    {
+        // **Test 1: Basic Section Detection**
+        char buffer[100] = {0};
+        int buffer_count = kv_parse_buffer_check_section("[section1]\n", buffer, sizeof(buffer));
+        assert(buffer_count == 8);
+        assert(strcmp(buffer, "section1") == 0);
+    }
+
+    printf("kv_parse_buffer_check_section() passed successfully!\n");
+}
+
+void run_kv_parse_span_check_section()
+{
+    {
+        // **Test 1: Basic Section Detection**
+        static const char input[] = "[section1]\n";
+        char buffer[100] = {0};
+        int buffer_count = kv_parse_span_check_section(input, input + strlen(input), buffer, sizeof(buffer));
+        assert(buffer_count == 8);
+        assert(strcmp(buffer, "section1") == 0);
+    }
+
+    {
+        // **Test 2: Closing Bracket Outside Slice**
+        static const char input[] = "[section1]\n";
+        char buffer[100] = {0};
+        int buffer_count = kv_parse_span_check_section(input, input + 9, buffer, sizeof(buffer));
+        assert(buffer_count == 0);
+        buffer_count = kv_parse_span_check_section(input, input + 1, buffer, sizeof(buffer));
+        assert(buffer_count == 0);
+    }
+
+    {
+        // **Test 3: Buffer Size Limits**
+        static const char input[] = "[section1]\n";
+        const char *end = input + strlen(input);
+        char buffer[100] = {0};
+        assert(kv_parse_span_check_section(input, end, buffer, 1) == 0);
+        assert(kv_parse_span_check_section(input, end, buffer, 10) == 0);
+        assert(kv_parse_span_check_section(input, end, buffer, 11) == 8);
+        assert(kv_parse_span_check_section(input, end, buffer, SIZE_MAX) == 8);
+        assert(strcmp(buffer, "section1") == 0);
+    }
+
+    printf("kv_parse_span_check_section() passed successfully!\n");
+}
+
+void run_kv_parse_check_section()
+{
+    {
+        // **Test 1: Basic Section Detection**
+        char buffer[100] = {0};
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+
+        fputs("[section1]\n", temp);
+        rewind(temp);
+
+        int buffer_count = kv_parse_check_section(temp, buffer, sizeof(buffer));
+
+        fclose(temp);
+        assert(buffer_count == 8);
+        assert(strcmp(buffer, "section1") == 0);
+    }
+
+    printf("kv_parse_check_section() passed successfully!\n");
+}
+
+// Run tests in main()
+int main()
+{
+    run_kv_parse_buffer_tests();
+    run_kv_parse_buffer_scan_tests();
+    run_kv_parse_span_tests();
+    run_kv_parse_buffer_get_value_view_tests();
+    run_kv_parse_buffer_iter_tests();
+    run_kv_parse_buffer_inplace_tests();
+    run_kv_parse_typed_tests();
+    run_kv_parse_tests();
+    run_kv_parse_reader_tests();
+    run_kv_parse_index_tests();
+    run_kv_parse_buffer_index_parallel_tests();
+    run_kv_parse_buffer_section_get_tests();
+    run_kv_parse_key_tests();
+    run_kv_parse_buffer_get_many_tests();
+    run_kv_parse_get_many_tests();
+    run_kv_parse_map_tests();
+    run_kv_parse_stream_tests();
+    run_kv_parse_class_tests();
+    run_kv_parse_escape_tests();
+    run_kv_parse_kvc_tests();
+    run_kv_parse_kvidx_tests();
+#ifdef __linux__
+    run_kv_parse_live_tests();
+#endif
+    run_kv_parse_pread_tests();
+    run_kv_parse_lines_tests();
+    run_kv_parse_bloom_tests();
     run_kv_parse_buffer_check_section();
+    run_kv_parse_span_check_section();
     run_kv_parse_check_section();
     printf("All tests passed successfully!\n");
     return 0;